@@ -21,6 +21,9 @@ struct Sass_Context; // : Sass_Options
 struct Sass_File_Context; // : Sass_Context
 struct Sass_Data_Context; // : Sass_Context
 
+// Forward declaration
+struct Sass_Dependency_Graph;
+
 // Compiler states
 enum Sass_Compiler_State {
   SASS_COMPILER_CREATED,
@@ -47,6 +50,11 @@ ADDAPI struct Sass_Compiler* ADDCALL sass_make_data_compiler (struct Sass_Data_C
 ADDAPI int ADDCALL sass_compiler_parse(struct Sass_Compiler* compiler);
 ADDAPI int ADDCALL sass_compiler_execute(struct Sass_Compiler* compiler);
 
+// Stop a compile that runs on another thread, or let it stop once
+// the given milliseconds passed (zero removes the deadline)
+ADDAPI void ADDCALL sass_compiler_cancel(struct Sass_Compiler* compiler);
+ADDAPI void ADDCALL sass_compiler_set_deadline(struct Sass_Compiler* compiler, size_t milliseconds);
+
 // Release all memory allocated with the compiler
 // This does _not_ include any contexts or options
 ADDAPI void ADDCALL sass_delete_compiler(struct Sass_Compiler* compiler);
@@ -77,15 +85,24 @@ ADDAPI bool ADDCALL sass_option_get_source_map_contents (struct Sass_Options* op
 ADDAPI bool ADDCALL sass_option_get_source_map_file_urls (struct Sass_Options* options);
 ADDAPI bool ADDCALL sass_option_get_omit_source_map_url (struct Sass_Options* options);
 ADDAPI bool ADDCALL sass_option_get_is_indented_syntax_src (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_merge_media_queries (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_merge_rules (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_remove_duplicate_declarations (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_legacy_passes (struct Sass_Options* options);
+ADDAPI size_t ADDCALL sass_option_get_max_memory (struct Sass_Options* options);
+ADDAPI size_t ADDCALL sass_option_get_max_output_size (struct Sass_Options* options);
+ADDAPI size_t ADDCALL sass_option_get_max_selector_permutations (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_indent (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_linefeed (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_input_path (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_output_path (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_source_map_file (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_source_map_root (struct Sass_Options* options);
+ADDAPI const char* ADDCALL sass_option_get_cache_path (struct Sass_Options* options);
 ADDAPI Sass_Importer_List ADDCALL sass_option_get_c_headers (struct Sass_Options* options);
 ADDAPI Sass_Importer_List ADDCALL sass_option_get_c_importers (struct Sass_Options* options);
 ADDAPI Sass_Function_List ADDCALL sass_option_get_c_functions (struct Sass_Options* options);
+ADDAPI struct Sass_Dependency_Graph* ADDCALL sass_option_get_dependency_graph (struct Sass_Options* options);
 
 // Setters for Context_Option values
 ADDAPI void ADDCALL sass_option_set_precision (struct Sass_Options* options, int precision);
@@ -96,6 +113,13 @@ ADDAPI void ADDCALL sass_option_set_source_map_contents (struct Sass_Options* op
 ADDAPI void ADDCALL sass_option_set_source_map_file_urls (struct Sass_Options* options, bool source_map_file_urls);
 ADDAPI void ADDCALL sass_option_set_omit_source_map_url (struct Sass_Options* options, bool omit_source_map_url);
 ADDAPI void ADDCALL sass_option_set_is_indented_syntax_src (struct Sass_Options* options, bool is_indented_syntax_src);
+ADDAPI void ADDCALL sass_option_set_merge_media_queries (struct Sass_Options* options, bool merge_media_queries);
+ADDAPI void ADDCALL sass_option_set_merge_rules (struct Sass_Options* options, bool merge_rules);
+ADDAPI void ADDCALL sass_option_set_remove_duplicate_declarations (struct Sass_Options* options, bool remove_duplicate_declarations);
+ADDAPI void ADDCALL sass_option_set_legacy_passes (struct Sass_Options* options, bool legacy_passes);
+ADDAPI void ADDCALL sass_option_set_max_memory (struct Sass_Options* options, size_t max_memory);
+ADDAPI void ADDCALL sass_option_set_max_output_size (struct Sass_Options* options, size_t max_output_size);
+ADDAPI void ADDCALL sass_option_set_max_selector_permutations (struct Sass_Options* options, size_t max_selector_permutations);
 ADDAPI void ADDCALL sass_option_set_indent (struct Sass_Options* options, const char* indent);
 ADDAPI void ADDCALL sass_option_set_linefeed (struct Sass_Options* options, const char* linefeed);
 ADDAPI void ADDCALL sass_option_set_input_path (struct Sass_Options* options, const char* input_path);
@@ -104,9 +128,11 @@ ADDAPI void ADDCALL sass_option_set_plugin_path (struct Sass_Options* options, c
 ADDAPI void ADDCALL sass_option_set_include_path (struct Sass_Options* options, const char* include_path);
 ADDAPI void ADDCALL sass_option_set_source_map_file (struct Sass_Options* options, const char* source_map_file);
 ADDAPI void ADDCALL sass_option_set_source_map_root (struct Sass_Options* options, const char* source_map_root);
+ADDAPI void ADDCALL sass_option_set_cache_path (struct Sass_Options* options, const char* cache_path);
 ADDAPI void ADDCALL sass_option_set_c_headers (struct Sass_Options* options, Sass_Importer_List c_headers);
 ADDAPI void ADDCALL sass_option_set_c_importers (struct Sass_Options* options, Sass_Importer_List c_importers);
 ADDAPI void ADDCALL sass_option_set_c_functions (struct Sass_Options* options, Sass_Function_List c_functions);
+ADDAPI void ADDCALL sass_option_set_dependency_graph (struct Sass_Options* options, struct Sass_Dependency_Graph* dependency_graph);
 
 
 // Getters for Sass_Context values
@@ -153,6 +179,10 @@ ADDAPI size_t ADDCALL sass_compiler_get_callee_stack_size(struct Sass_Compiler*
 ADDAPI Sass_Callee_Entry ADDCALL sass_compiler_get_last_callee(struct Sass_Compiler* compiler);
 ADDAPI Sass_Callee_Entry ADDCALL sass_compiler_get_callee_entry(struct Sass_Compiler* compiler, size_t idx);
 
+// Statistics of the import resolution (files checked on disk, lookups served from memory)
+ADDAPI size_t ADDCALL sass_compiler_get_file_probes(struct Sass_Compiler* compiler);
+ADDAPI size_t ADDCALL sass_compiler_get_file_probe_hits(struct Sass_Compiler* compiler);
+
 // Push function for paths (no manipulation support for now)
 ADDAPI void ADDCALL sass_option_push_plugin_path (struct Sass_Options* options, const char* path);
 ADDAPI void ADDCALL sass_option_push_include_path (struct Sass_Options* options, const char* path);
@@ -167,6 +197,16 @@ ADDAPI char* ADDCALL sass_find_include (const char* path, struct Sass_Options* o
 ADDAPI char* ADDCALL sass_compiler_find_file (const char* path, struct Sass_Compiler* compiler);
 ADDAPI char* ADDCALL sass_compiler_find_include (const char* path, struct Sass_Compiler* compiler);
 
+// Import dependency graph kept across compilations (for watchers)
+// Every context using it records the files its entry point loaded
+ADDAPI struct Sass_Dependency_Graph* ADDCALL sass_make_dependency_graph (void);
+ADDAPI void ADDCALL sass_delete_dependency_graph (struct Sass_Dependency_Graph* graph);
+// Entry points affected by the changed files (null terminated lists)
+// Files whose contents did not change since the last compile are ignored
+ADDAPI char** ADDCALL sass_dependency_graph_get_affected_entries (struct Sass_Dependency_Graph* graph, const char** changed_files);
+// Forget about an entry point that is no longer compiled
+ADDAPI void ADDCALL sass_dependency_graph_forget_entry (struct Sass_Dependency_Graph* graph, const char* entry);
+
 #ifdef __cplusplus
 } // __cplusplus defined.
 #endif
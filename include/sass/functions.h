@@ -32,6 +32,10 @@ typedef struct Sass_Importer* (*Sass_Importer_List);
 // Typedef defining importer signature and return type
 typedef Sass_Import_List (*Sass_Importer_Fn)
   (const char* url, Sass_Importer_Entry cb, struct Sass_Compiler* compiler);
+// Typedef defining the optional prefetch hook of an importer
+// Gets all urls imported by a stylesheet (null terminated)
+typedef void (*Sass_Importer_Prefetch_Fn)
+  (const char** urls, Sass_Importer_Entry cb, struct Sass_Compiler* compiler);
 
 // Typedef helpers for custom functions lists
 typedef struct Sass_Function (*Sass_Function_Entry);
@@ -63,6 +67,15 @@ ADDAPI Sass_Importer_Fn ADDCALL sass_importer_get_function (Sass_Importer_Entry
 ADDAPI double ADDCALL sass_importer_get_priority (Sass_Importer_Entry cb);
 ADDAPI void* ADDCALL sass_importer_get_cookie (Sass_Importer_Entry cb);
 
+// Optional hook to receive the imports of a stylesheet in one batch
+ADDAPI void ADDCALL sass_importer_set_prefetch (Sass_Importer_Entry cb, Sass_Importer_Prefetch_Fn prefetch);
+ADDAPI Sass_Importer_Prefetch_Fn ADDCALL sass_importer_get_prefetch (Sass_Importer_Entry cb);
+
+// Promise to return the same imports whenever the files they point to are
+// unchanged (compilations may then be served from the result cache)
+ADDAPI void ADDCALL sass_importer_set_deterministic (Sass_Importer_Entry cb, bool deterministic);
+ADDAPI bool ADDCALL sass_importer_get_deterministic (Sass_Importer_Entry cb);
+
 // Deallocator for associated memory
 ADDAPI void ADDCALL sass_delete_importer (Sass_Importer_Entry cb);
 
@@ -131,6 +144,11 @@ ADDAPI const char* ADDCALL sass_function_get_signature (Sass_Function_Entry cb);
 ADDAPI Sass_Function_Fn ADDCALL sass_function_get_function (Sass_Function_Entry cb);
 ADDAPI void* ADDCALL sass_function_get_cookie (Sass_Function_Entry cb);
 
+// Promise to return the same value whenever called with the same arguments
+// (compilations may then be served from the result cache)
+ADDAPI void ADDCALL sass_function_set_deterministic (Sass_Function_Entry cb, bool deterministic);
+ADDAPI bool ADDCALL sass_function_get_deterministic (Sass_Function_Entry cb);
+
 
 #ifdef __cplusplus
 } // __cplusplus defined.
@@ -2,7 +2,8 @@
 // MurmurHash2 was written by Austin Appleby, and is placed in the public
 // domain. The author hereby disclaims copyright to this source code.
 //-----------------------------------------------------------------------------
-// LibSass only needs MurmurHash2, so we made this header only
+// LibSass only needs MurmurHash2 and MurmurHash64A, so we made this
+// header only
 //-----------------------------------------------------------------------------
 
 #ifndef _MURMURHASH2_H_
@@ -85,6 +86,58 @@ inline uint32_t MurmurHash2 ( const void * key, int len, uint32_t seed )
   return h;
 } 
 
+//-----------------------------------------------------------------------------
+// MurmurHash64A, the 64-bit variant for 64-bit platforms
+
+inline uint64_t MurmurHash64A ( const void * key, int len, uint64_t seed )
+{
+  const uint64_t m = 0xc6a4a7935bd1e995ULL;
+  const int r = 47;
+
+  uint64_t h = seed ^ (uint64_t(len) * m);
+
+  const unsigned char * data = (const unsigned char *)key;
+  const unsigned char * end = data + (len / 8) * 8;
+
+  while(data != end)
+  {
+    uint64_t k = *(uint64_t*)data;
+
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+
+    h ^= k;
+    h *= m;
+
+    data += 8;
+  }
+
+  switch(len & 7)
+  {
+  case 7: h ^= uint64_t(data[6]) << 48;
+    /* fall through */
+  case 6: h ^= uint64_t(data[5]) << 40;
+    /* fall through */
+  case 5: h ^= uint64_t(data[4]) << 32;
+    /* fall through */
+  case 4: h ^= uint64_t(data[3]) << 24;
+    /* fall through */
+  case 3: h ^= uint64_t(data[2]) << 16;
+    /* fall through */
+  case 2: h ^= uint64_t(data[1]) << 8;
+    /* fall through */
+  case 1: h ^= uint64_t(data[0]);
+    h *= m;
+  };
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+
+  return h;
+}
+
 //-----------------------------------------------------------------------------
 
 #endif // _MURMURHASH2_H_
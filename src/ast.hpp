@@ -5,6 +5,7 @@
 // __EXTENSIONS__ fix on Solaris.
 #include "sass.hpp"
 
+#include <cstdint>
 #include <typeinfo>
 #include <unordered_map>
 
@@ -351,98 +352,136 @@ namespace Sass {
   inline Vectorized<T>::~Vectorized() { }
 
   /////////////////////////////////////////////////////////////////////////////
-  // Mixin class for AST nodes that should behave like a hash table. Uses an
-  // extra <sass::vector> internally to maintain insertion order for interation.
+  // Mixin class for AST nodes that should behave like a hash table. Entries
+  // are stored once in dense arrays in insertion order, which are indexed by
+  // a small open-addressing table (linear probing) of entry positions.
   /////////////////////////////////////////////////////////////////////////////
   template <typename K, typename T, typename U>
   class Hashed {
   private:
-    std::unordered_map<
-      K, T, ObjHash, ObjHashEquality
-    > elements_;
-
+    // Dense entry arrays in insertion order
     sass::vector<K> _keys;
     sass::vector<T> _values;
+    // Cached key hashes (parallel to keys)
+    sass::vector<size_t> _hashes;
+    // Power of two sized index table, each slot
+    // holds entry position plus one (zero is empty)
+    sass::vector<uint32_t> _index;
   protected:
     mutable size_t hash_;
     K duplicate_key_;
     void reset_hash() { hash_ = 0; }
     void reset_duplicate_key() { duplicate_key_ = {}; }
     virtual void adjust_after_pushing(std::pair<K, T> p) { }
+  private:
+    static const size_t npos = sass::string::npos;
+    // Return position of `k` in the entry arrays
+    size_t find(const K& k, size_t h) const
+    {
+      if (_index.empty()) return npos;
+      const size_t mask = _index.size() - 1;
+      for (size_t i = h & mask; ; i = (i + 1) & mask) {
+        const uint32_t slot = _index[i];
+        if (slot == 0) return npos;
+        if (_hashes[slot - 1] == h &&
+            ObjHashEquality()(_keys[slot - 1], k)) {
+          return slot - 1;
+        }
+      }
+    }
+    // Insert entry position into the index table
+    void link(size_t pos)
+    {
+      const size_t mask = _index.size() - 1;
+      size_t i = _hashes[pos] & mask;
+      while (_index[i] != 0) i = (i + 1) & mask;
+      _index[i] = static_cast<uint32_t>(pos + 1);
+    }
+    // Rebuild index to hold at least `size` entries
+    // while keeping the load factor below one half
+    void rehash(size_t size)
+    {
+      size_t capacity = 8;
+      while (capacity < size * 2) capacity *= 2;
+      if (capacity <= _index.size()) return;
+      _index.assign(capacity, 0);
+      for (size_t i = 0; i < _keys.size(); i += 1) link(i);
+    }
   public:
     Hashed(size_t s = 0)
-    : elements_(),
-      _keys(),
+    : _keys(),
       _values(),
+      _hashes(),
+      _index(),
       hash_(0), duplicate_key_({})
     {
       _keys.reserve(s);
       _values.reserve(s);
-      elements_.reserve(s);
+      _hashes.reserve(s);
+      if (s > 0) rehash(s);
     }
     virtual ~Hashed();
     size_t length() const                  { return _keys.size(); }
     bool empty() const                     { return _keys.empty(); }
     bool has(K k) const          {
-      return elements_.find(k) != elements_.end();
+      return find(k, ObjHashFn(k)) != npos;
     }
     T at(K k) const {
-      if (elements_.count(k))
-      {
-        return elements_.at(k);
-      }
-      else { return {}; }
+      size_t pos = find(k, ObjHashFn(k));
+      if (pos == npos) return {};
+      return _values[pos];
     }
     bool has_duplicate_key() const         { return duplicate_key_ != nullptr; }
     K get_duplicate_key() const  { return duplicate_key_; }
-    const std::unordered_map<
-      K, T, ObjHash, ObjHashEquality
-    >& elements() { return elements_; }
     Hashed& operator<<(std::pair<K, T> p)
     {
       reset_hash();
 
-      if (!has(p.first)) {
+      size_t h = ObjHashFn(p.first);
+      size_t pos = find(p.first, h);
+      if (pos == npos) {
         _keys.push_back(p.first);
         _values.push_back(p.second);
+        _hashes.push_back(h);
+        if (_keys.size() * 2 > _index.size()) {
+          rehash(_keys.size());
+        }
+        else {
+          link(_keys.size() - 1);
+        }
       }
-      else if (!duplicate_key_) {
-        duplicate_key_ = p.first;
+      else {
+        _values[pos] = p.second;
+        if (!duplicate_key_) {
+          duplicate_key_ = p.first;
+        }
       }
 
-      elements_[p.first] = p.second;
-
       adjust_after_pushing(p);
       return *this;
     }
     Hashed& operator+=(Hashed* h)
     {
       if (length() == 0) {
-        this->elements_ = h->elements_;
-        this->_values = h->_values;
         this->_keys = h->_keys;
+        this->_values = h->_values;
+        this->_hashes = h->_hashes;
+        this->_index = h->_index;
         return *this;
       }
 
-      for (auto key : h->keys()) {
-        *this << std::make_pair(key, h->at(key));
+      rehash(length() + h->length());
+      for (size_t i = 0; i < h->length(); i += 1) {
+        *this << std::make_pair(h->_keys[i], h->_values[i]);
       }
 
       reset_duplicate_key();
       return *this;
     }
-    const std::unordered_map<
-      K, T, ObjHash, ObjHashEquality
-    >& pairs() const { return elements_; }
 
     const sass::vector<K>& keys() const { return _keys; }
     const sass::vector<T>& values() const { return _values; }
 
-//    std::unordered_map<ExpressionObj, ExpressionObj>::iterator end() { return elements_.end(); }
-//    std::unordered_map<ExpressionObj, ExpressionObj>::iterator begin() { return elements_.begin(); }
-//    std::unordered_map<ExpressionObj, ExpressionObj>::const_iterator end() const { return elements_.end(); }
-//    std::unordered_map<ExpressionObj, ExpressionObj>::const_iterator begin() const { return elements_.begin(); }
-
   };
   template <typename K, typename T, typename U>
   inline Hashed<K, T, U>::~Hashed() { }
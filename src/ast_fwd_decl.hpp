@@ -231,7 +231,7 @@ namespace Sass {
   typedef sass::vector<Sass_Import_Entry> ImporterStack;
 
   // only to switch implementations for testing
-  #define environment_map std::map
+  #define environment_map std::unordered_map
 
   // ###########################################################################
   // explicit type conversion functions
@@ -5,6 +5,7 @@
 #include "ast.hpp"
 #include "permutate.hpp"
 #include "dart_helpers.hpp"
+#include "error_handling.hpp"
 
 namespace Sass {
 
@@ -454,6 +455,16 @@ namespace Sass {
   }
   // EO mergeFinalCombinators
 
+  // ##########################################################################
+  // Helper function used by `weave` and `weaveParents`
+  // ##########################################################################
+  static void permutationsExceeded(size_t max_permutations)
+  {
+    sass::ostream msg;
+    msg << "Selectors need more than " << max_permutations << " permutations";
+    throw Exception::BudgetExceeded(msg.str());
+  }
+
   // ##########################################################################
   // Expands "parenthesized selectors" in [complexes]. That is, if
   // we have `.A .B {@extend .C}` and `.D .C {...}`, this conceptually
@@ -462,9 +473,11 @@ namespace Sass {
   // would also be required, but including merged selectors results in
   // exponential output for very little gain. The selector `.D (.A .B)`
   // is represented as the list `[[.D], [.A, .B]]`.
+  // Throws if more than [max_permutations] are needed (unless zero).
   // ##########################################################################
   sass::vector<sass::vector<SelectorComponentObj>> weave(
-    const sass::vector<sass::vector<SelectorComponentObj>>& complexes) {
+    const sass::vector<sass::vector<SelectorComponentObj>>& complexes,
+    size_t max_permutations) {
 
     sass::vector<sass::vector<SelectorComponentObj>> prefixes;
 
@@ -491,12 +504,15 @@ namespace Sass {
       sass::vector<sass::vector<SelectorComponentObj>> newPrefixes;
       for (sass::vector<SelectorComponentObj> prefix : prefixes) {
         sass::vector<sass::vector<SelectorComponentObj>>
-          parentPrefixes = weaveParents(prefix, parents);
+          parentPrefixes = weaveParents(prefix, parents, max_permutations);
         if (parentPrefixes.empty()) continue;
         for (auto& parentPrefix : parentPrefixes) {
           parentPrefix.push_back(target);
           newPrefixes.push_back(parentPrefix);
         }
+        if (max_permutations && newPrefixes.size() > max_permutations) {
+          permutationsExceeded(max_permutations);
+        }
       }
       prefixes = newPrefixes;
 
@@ -518,10 +534,12 @@ namespace Sass {
   // of elements matched by `AB_i X` is identical to the intersection of all
   // elements matched by `A X` and all elements matched by `B X`. Some `AB_i`
   // are elided to reduce the size of the output.
+  // Throws if more than [max_permutations] are needed (unless zero).
   // ##########################################################################
   sass::vector<sass::vector<SelectorComponentObj>> weaveParents(
     sass::vector<SelectorComponentObj> queue1,
-    sass::vector<SelectorComponentObj> queue2)
+    sass::vector<SelectorComponentObj> queue2,
+    size_t max_permutations)
   {
 
     sass::vector<SelectorComponentObj> leads;
@@ -601,6 +619,11 @@ namespace Sass {
     choices.erase(std::remove_if(choices.begin(), choices.end(), checkForEmptyChild
       <sass::vector<sass::vector<SelectorComponentObj>>>), choices.end());
 
+    // refuse to create more paths than allowed
+    if (max_permutations && countPermutations(choices, max_permutations) > max_permutations) {
+      permutationsExceeded(max_permutations);
+    }
+
     // permutate all possible paths through selectors
     sass::vector<sass::vector<SelectorComponentObj>>
       results = flattenInner(permutate(choices));
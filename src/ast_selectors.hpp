@@ -22,11 +22,13 @@ namespace Sass {
     const sass::vector<SelectorComponentObj>& complex2);
 
     sass::vector<sass::vector<SelectorComponentObj>> weave(
-    const sass::vector<sass::vector<SelectorComponentObj>>& complexes);
+    const sass::vector<sass::vector<SelectorComponentObj>>& complexes,
+    size_t max_permutations = 0);
 
   sass::vector<sass::vector<SelectorComponentObj>> weaveParents(
     sass::vector<SelectorComponentObj> parents1,
-    sass::vector<SelectorComponentObj> parents2);
+    sass::vector<SelectorComponentObj> parents2,
+    size_t max_permutations = 0);
 
   sass::vector<SimpleSelectorObj> unifyCompound(
     const sass::vector<SimpleSelectorObj>& compound1,
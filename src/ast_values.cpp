@@ -993,7 +993,8 @@ namespace Sass {
   : String(ptr),
     quote_mark_(ptr->quote_mark_),
     value_(ptr->value_),
-    hash_(ptr->hash_)
+    hash_(ptr->hash_),
+    code_points_(ptr->code_points_)
   { }
 
   bool String_Constant::is_invisible() const {
@@ -1031,6 +1032,7 @@ namespace Sass {
   void String_Constant::rtrim()
   {
     str_rtrim(value_);
+    code_points_ = {};
   }
 
   size_t String_Constant::hash() const
@@ -1041,6 +1043,14 @@ namespace Sass {
     return hash_;
   }
 
+  const UTF_8::CodePoints& String_Constant::code_points() const
+  {
+    if (!code_points_) {
+      code_points_ = SASS_MEMORY_NEW(UTF_8::CodePoints, value_);
+    }
+    return *code_points_;
+  }
+
   /////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////
 
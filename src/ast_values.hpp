@@ -5,6 +5,7 @@
 // __EXTENSIONS__ fix on Solaris.
 #include "sass.hpp"
 #include "ast.hpp"
+#include "utf8_string.hpp"
 
 namespace Sass {
 
@@ -417,10 +418,14 @@ namespace Sass {
   ////////////////////////////////////////////////////////
   class String_Constant : public String {
     ADD_PROPERTY(char, quote_mark)
-    HASH_CONSTREF(sass::string, value)
   protected:
+    sass::string value_;
     mutable size_t hash_;
+    // built on first use by the string functions
+    mutable SharedImpl<UTF_8::CodePoints> code_points_;
   public:
+    const sass::string& value() const { return value_; }
+    void value(sass::string value) { hash_ = 0; code_points_ = {}; value_ = value; }
     String_Constant(SourceSpan pstate, sass::string val, bool css = true);
     String_Constant(SourceSpan pstate, const char* beg, bool css = true);
     String_Constant(SourceSpan pstate, const char* beg, const char* end, bool css = true);
@@ -430,6 +435,10 @@ namespace Sass {
     bool is_invisible() const override;
     virtual void rtrim() override;
     size_t hash() const override;
+    // code point index of the value
+    const UTF_8::CodePoints& code_points() const;
+    // take over the index of a string with the same value
+    void share_code_points(const String_Constant* str) { code_points_ = str->code_points_; }
     bool operator< (const Expression& rhs) const override;
     bool operator==(const Expression& rhs) const override;
     // quotes are forced on inspection
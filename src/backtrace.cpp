@@ -2,6 +2,15 @@
 
 namespace Sass {
 
+  sass::string Backtrace::caller() const
+  {
+    switch (kind) {
+      case FUNCTION: return ", in function `" + name + "`";
+      case MIXIN: return ", in mixin `" + name + "`";
+      default: return "";
+    }
+  }
+
   const sass::string traces_to_string(Backtraces traces, sass::string indent) {
 
     sass::ostream ss;
@@ -18,7 +27,7 @@ namespace Sass {
       sass::string rel_path(File::abs2rel(trace.pstate.getPath(), cwd, cwd));
 
       // skip functions on error cases (unsure why ruby sass does this)
-      // if (trace.caller.substr(0, 6) == ", in f") continue;
+      // if (trace.caller().substr(0, 6) == ", in f") continue;
 
       if (first) {
         ss << indent;
@@ -27,10 +36,10 @@ namespace Sass {
         ss << ":";
         ss << trace.pstate.getColumn();
         ss << " of " << rel_path;
-        // ss << trace.caller;
+        // ss << trace.caller();
         first = false;
       } else {
-        ss << trace.caller;
+        ss << trace.caller();
         ss << std::endl;
         ss << indent;
         ss << "from line ";
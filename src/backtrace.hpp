@@ -10,14 +10,24 @@ namespace Sass {
 
   struct Backtrace {
 
+    // what kind of call opened this frame
+    enum Kind { NONE, FUNCTION, MIXIN };
+
     SourceSpan pstate;
-    sass::string caller;
+    Kind kind;
+    // only the callee name is kept, the
+    // message is built when it's printed
+    sass::string name;
 
-    Backtrace(SourceSpan pstate, sass::string c = "")
+    Backtrace(SourceSpan pstate, Kind kind = NONE, const sass::string& name = "")
     : pstate(pstate),
-      caller(c)
+      kind(kind),
+      name(name)
     { }
 
+    // e.g. ", in function `foo`"
+    sass::string caller() const;
+
   };
 
   typedef sass::vector<Backtrace> Backtraces;
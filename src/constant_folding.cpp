@@ -0,0 +1,169 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+#include "ast.hpp"
+
+#include "constant_folding.hpp"
+#include "operators.hpp"
+
+namespace Sass {
+
+  Constant_Folding::Constant_Folding(struct Sass_Inspect_Options& opt)
+  : opt(opt)
+  { }
+
+  // Return the folded expression or the original one.
+  // We only fold what `Eval` would compute without any
+  // context, so results are exactly the same as before.
+  Expression* Constant_Folding::fold(Expression* ex)
+  {
+    if (ex == nullptr) return ex;
+
+    if (Binary_Expression* b = Cast<Binary_Expression>(ex)) {
+      b->left(fold(b->left()));
+      b->right(fold(b->right()));
+      // division may be a separator (e.g. `font: 1px/2px`)
+      switch (b->optype()) {
+        case Sass_OP::ADD: case Sass_OP::SUB:
+        case Sass_OP::MUL: case Sass_OP::MOD: break;
+        default: return b;
+      }
+      if (b->is_delayed() || b->is_interpolant()) return b;
+      Number* lhs = Cast<Number>(b->left());
+      Number* rhs = Cast<Number>(b->right());
+      if (!lhs || !rhs) return b;
+      if (lhs->is_interpolant() || rhs->is_interpolant()) return b;
+      try {
+        // same call as the fast path in `Eval`
+        ValueObj rv = Operators::op_numbers(b->optype(),
+          *lhs, *rhs, opt, b->pstate());
+        // e.g. `1 % 0` results in a string
+        if (Cast<Number>(rv)) return rv.detach();
+      }
+      // leave errors to be reported by `Eval`
+      catch (Exception::OperationError&) {}
+      return b;
+    }
+    else if (List* l = Cast<List>(ex)) {
+      for (size_t i = 0, L = l->length(); i < L; ++i) {
+        l->at(i) = fold(l->at(i));
+      }
+    }
+    else if (Unary_Expression* u = Cast<Unary_Expression>(ex)) {
+      u->operand(fold(u->operand()));
+    }
+    else if (Function_Call* c = Cast<Function_Call>(ex)) {
+      fold(c->arguments());
+    }
+    else if (Argument* a = Cast<Argument>(ex)) {
+      a->value(fold(a->value()));
+    }
+
+    return ex;
+  }
+
+  void Constant_Folding::fold(Arguments* args)
+  {
+    if (args == nullptr) return;
+    for (size_t i = 0, L = args->length(); i < L; ++i) {
+      fold(args->at(i));
+    }
+  }
+
+  void Constant_Folding::fold(Parameters* params)
+  {
+    if (params == nullptr) return;
+    for (size_t i = 0, L = params->length(); i < L; ++i) {
+      Parameter* param = params->at(i);
+      param->default_value(fold(param->default_value()));
+    }
+  }
+
+  void Constant_Folding::operator()(Block* b)
+  {
+    for (size_t i = 0, L = b->length(); i < L; ++i) {
+      if (b->get(i)) b->get(i)->perform(this);
+    }
+  }
+
+  void Constant_Folding::operator()(StyleRule* r)
+  {
+    if (r->block()) r->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(MediaRule* m)
+  {
+    if (m->block()) m->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(SupportsRule* m)
+  {
+    if (m->block()) m->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(AtRootRule* a)
+  {
+    if (a->block()) a->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(AtRule* a)
+  {
+    if (a->block()) a->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(Declaration* d)
+  {
+    // custom properties are passed through verbatim
+    if (!d->is_custom_property()) d->value(fold(d->value()));
+    if (d->block()) d->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(Assignment* a)
+  {
+    a->value(fold(a->value()));
+  }
+
+  void Constant_Folding::operator()(If* i)
+  {
+    i->predicate(fold(i->predicate()));
+    if (i->block()) i->block()->perform(this);
+    if (i->alternative()) i->alternative()->perform(this);
+  }
+
+  void Constant_Folding::operator()(ForRule* f)
+  {
+    f->lower_bound(fold(f->lower_bound()));
+    f->upper_bound(fold(f->upper_bound()));
+    if (f->block()) f->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(EachRule* e)
+  {
+    e->list(fold(e->list()));
+    if (e->block()) e->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(WhileRule* w)
+  {
+    w->predicate(fold(w->predicate()));
+    if (w->block()) w->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(Return* r)
+  {
+    r->value(fold(r->value()));
+  }
+
+  void Constant_Folding::operator()(Definition* d)
+  {
+    fold(d->parameters());
+    if (d->block()) d->block()->perform(this);
+  }
+
+  void Constant_Folding::operator()(Mixin_Call* c)
+  {
+    fold(c->arguments());
+    if (c->block()) c->block()->perform(this);
+  }
+
+}
@@ -0,0 +1,51 @@
+#ifndef SASS_CONSTANT_FOLDING_H
+#define SASS_CONSTANT_FOLDING_H
+
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+#include "ast_fwd_decl.hpp"
+#include "operation.hpp"
+
+namespace Sass {
+
+  // Post-parse pass that replaces fully literal arithmetic
+  // (e.g. `1px + 2px`) with its result, so mixin bodies and
+  // loops don't re-evaluate the same expression on each run.
+  class Constant_Folding : public Operation_CRTP<void, Constant_Folding> {
+
+    struct Sass_Inspect_Options& opt;
+
+    Expression* fold(Expression*);
+    void fold(Arguments*);
+    void fold(Parameters*);
+
+  public:
+    Constant_Folding(struct Sass_Inspect_Options& opt);
+    ~Constant_Folding() { }
+
+    void operator()(Block*);
+    void operator()(StyleRule*);
+    void operator()(MediaRule*);
+    void operator()(SupportsRule*);
+    void operator()(AtRootRule*);
+    void operator()(AtRule*);
+    void operator()(Declaration*);
+    void operator()(Assignment*);
+    void operator()(If*);
+    void operator()(ForRule*);
+    void operator()(EachRule*);
+    void operator()(WhileRule*);
+    void operator()(Return*);
+    void operator()(Definition*);
+    void operator()(Mixin_Call*);
+
+    // ignore missed types
+    template <typename U>
+    void fallback(U x) {}
+
+  };
+
+}
+
+#endif
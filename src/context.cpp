@@ -4,8 +4,10 @@
 #include "ast.hpp"
 
 #include "remove_placeholders.hpp"
+#include "optimize_rules.hpp"
 #include "sass_functions.hpp"
 #include "check_nesting.hpp"
+#include "constant_folding.hpp"
 #include "fn_selectors.hpp"
 #include "fn_strings.hpp"
 #include "fn_numbers.hpp"
@@ -58,7 +60,9 @@ namespace Sass {
     callee_stack(),
     traces(),
     extender(Extender::NORMAL, traces),
+    interrupt(c_options.max_memory, c_options.max_output_size, c_options.max_selector_permutations),
     c_compiler(NULL),
+    deterministic(true),
 
     c_headers               (sass::vector<Sass_Importer_Entry>()),
     c_importers             (sass::vector<Sass_Importer_Entry>()),
@@ -95,6 +99,8 @@ namespace Sass {
     sort (c_importers.begin(), c_importers.end(), sort_importers);
 
     emitter.set_filename(abs2rel(output_path, source_map_file, CWD));
+    emitter.interrupt = &interrupt;
+    extender.interrupt = &interrupt;
 
   }
 
@@ -222,12 +228,12 @@ namespace Sass {
     // make sure we resolve against an absolute path
     sass::string base_path(rel2abs(import.base_path));
     // first try to resolve the load path relative to the base path
-    sass::vector<Include> vec(resolve_includes(base_path, import.imp_path));
+    sass::vector<Include> vec(resolve_includes(base_path, import.imp_path, resolver_cache));
     // then search in every include path (but only if nothing found yet)
     for (size_t i = 0, S = include_paths.size(); vec.size() == 0 && i < S; ++i)
     {
       // call resolve_includes and individual base path and append all results
-      sass::vector<Include> resolved(resolve_includes(include_paths[i], import.imp_path));
+      sass::vector<Include> resolved(resolve_includes(include_paths[i], import.imp_path, resolver_cache));
       if (resolved.size()) vec.insert(vec.end(), resolved.begin(), resolved.end());
     }
     // return vector
@@ -298,6 +304,9 @@ namespace Sass {
       }
     }
 
+    // let importers start on our imports early
+    prefetch_imports(contents);
+
     // create a parser instance from the given c_str buffer
     Parser p(source, *this, traces);
     // do not yet dispose these buffers
@@ -305,6 +314,9 @@ namespace Sass {
     sass_import_take_srcmap(import);
     // then parse the root block
     Block_Obj root = p.parse();
+    // fold literal expressions once per stylesheet
+    Constant_Folding constant_folding(c_options);
+    root->perform(&constant_folding);
     // delete memory of current stack frame
     sass_delete_import(import_stack.back());
     // remove current stack frame
@@ -483,6 +495,57 @@ namespace Sass {
     return has_import;
   }
 
+  // cheap scan for the urls of all quoted imports in a stylesheet
+  // does not know about nesting, so false positives are possible
+  static sass::vector<sass::string> scan_import_urls(const char* src)
+  {
+    using namespace Prelexer;
+    sass::vector<sass::string> urls;
+    while (*src) {
+      if (const char* end = alternatives < line_comment, block_comment, quoted_string >(src)) {
+        src = end;
+      }
+      else if (const char* end = word < import_kwd >(src)) {
+        src = optional_css_comments(end);
+        while (const char* end = quoted_string(src)) {
+          sass::string url(unquote(sass::string(src, end)));
+          // the url of interpolated imports is not known yet
+          if (url.find("#{") == sass::string::npos) urls.push_back(url);
+          src = optional_css_comments(end);
+          if (*src != ',') break;
+          src = optional_css_comments(src + 1);
+        }
+      }
+      else {
+        ++ src;
+      }
+    }
+    return urls;
+  }
+
+  // hand all imports of the stylesheet about to be parsed to the
+  // importers with a prefetch hook, so they can start resolving
+  // them concurrently while we parse; the importer itself is
+  // still called for each import once the parser reaches it
+  void Context::prefetch_imports(const char* contents)
+  {
+    bool has_prefetch = false;
+    for (Sass_Importer_Entry importer : c_importers) {
+      if (sass_importer_get_prefetch(importer)) has_prefetch = true;
+    }
+    if (!has_prefetch) return;
+    sass::vector<sass::string> urls(scan_import_urls(contents));
+    if (urls.empty()) return;
+    sass::vector<const char*> list;
+    for (const sass::string& url : urls) list.push_back(url.c_str());
+    list.push_back(nullptr);
+    for (Sass_Importer_Entry importer : c_importers) {
+      if (Sass_Importer_Prefetch_Fn prefetch = sass_importer_get_prefetch(importer)) {
+        prefetch(list.data(), importer, c_compiler);
+      }
+    }
+  }
+
   void register_function(Context&, Signature sig, Native_Function f, Env* env);
   void register_function(Context&, Signature sig, Native_Function f, size_t arity, Env* env);
   void register_overload_stub(Context&, sass::string name, Env* env);
@@ -499,23 +562,29 @@ namespace Sass {
     // finish emitter stream
     emitter.finalize();
     // get the resulting buffer from stream
-    OutputBuffer emitted = emitter.get_buffer();
+    const OutputBuffer& emitted = emitter.get_buffer();
+    interrupt.check_output(emitted.buffer.size());
     // should we append a source map url?
+    sass::string footer;
     if (!c_options.omit_source_map_url) {
       // generate an embedded source map
       if (c_options.source_map_embed) {
-        emitted.buffer += linefeed;
-        emitted.buffer += format_embedded_source_map();
+        footer += linefeed;
+        footer += format_embedded_source_map();
       }
       // or just link the generated one
       else if (source_map_file != "") {
-        emitted.buffer += linefeed;
-        emitted.buffer += format_source_mapping_url(source_map_file);
+        footer += linefeed;
+        footer += format_source_mapping_url(source_map_file);
       }
     }
-    // create a copy of the resulting buffer string
+    // copy buffer and footer into the resulting string
     // this must be freed or taken over by implementor
-    return sass_copy_c_string(emitted.buffer.c_str());
+    size_t size = emitted.buffer.size();
+    char* result = (char*) sass_alloc_memory(size + footer.size() + 1);
+    std::memcpy(result, emitted.buffer.data(), size);
+    std::memcpy(result + size, footer.c_str(), footer.size() + 1);
+    return result;
   }
 
   void Context::apply_custom_headers(Block_Obj root, const char* ctx_path, SourceSpan pstate)
@@ -658,15 +727,31 @@ namespace Sass {
       throw Exception::UnsatisfiedExtend(traces, unsatisfied);
     }
 
-    // check nesting
-    check_nesting(root);
+    // check nesting, expand flags when it is needed
+    if (c_options.legacy_passes || expand.nesting_suspect) {
+      check_nesting(root);
+    }
     // merge and bubble certain rules
+    // this also removes placeholders
     root = cssize(root);
 
     // clean up by removing empty placeholders
-    // ToDo: maybe we can do this somewhere else?
-    Remove_Placeholders remove_placeholders;
-    root->perform(&remove_placeholders);
+    if (c_options.legacy_passes) {
+      Remove_Placeholders remove_placeholders;
+      root->perform(&remove_placeholders);
+    }
+
+    // optionally join adjacent media rules
+    if (c_options.merge_media_queries) {
+      cssize.merge_media_queries(root);
+    }
+
+    // optionally shrink the output further
+    if (c_options.merge_rules || c_options.remove_duplicate_declarations) {
+      Optimize_Rules optimize_rules(c_options,
+        c_options.merge_rules, c_options.remove_duplicate_declarations);
+      root->perform(&optimize_rules);
+    }
 
     // return processed tree
     return root;
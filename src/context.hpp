@@ -14,6 +14,7 @@
 #include "stylesheet.hpp"
 #include "plugins.hpp"
 #include "output.hpp"
+#include "interrupt.hpp"
 
 namespace Sass {
 
@@ -27,6 +28,7 @@ namespace Sass {
 
   private:
     bool call_loader(const sass::string& load_path, const char* ctx_path, SourceSpan& pstate, Import* imp, sass::vector<Sass_Importer_Entry> importers, bool only_one = true);
+    void prefetch_imports(const char* contents);
 
   public:
     const sass::string CWD;
@@ -48,8 +50,17 @@ namespace Sass {
     sass::vector<Sass_Callee> callee_stack;
     sass::vector<Backtrace> traces;
     Extender extender;
+    // lets another thread stop the compile
+    // and enforces the budgets from the options
+    Interrupt interrupt;
+    // selectors parsed from interpolated text, by schema and text,
+    // empty until the text was seen a second time
+    std::unordered_map<Selector_Schema_Obj, std::unordered_map<sass::string, SelectorListObj>,
+      ObjPtrHash, ObjPtrEquality> parsed_selectors;
 
     struct Sass_Compiler* c_compiler;
+    // cleared once random values are used
+    bool deterministic;
 
     // absolute paths to includes
     sass::vector<sass::string> included_files;
@@ -59,6 +70,7 @@ namespace Sass {
 
     sass::vector<sass::string> plugin_paths; // relative paths to load plugins
     sass::vector<sass::string> include_paths; // lookup paths for includes
+    File::ResolverCache resolver_cache; // file system probes for includes
 
     void apply_custom_headers(Block_Obj root, const char* path, SourceSpan pstate);
 
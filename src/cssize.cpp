@@ -14,7 +14,9 @@ namespace Sass {
   Cssize::Cssize(Context& ctx)
   : traces(ctx.traces),
     block_stack(BlockStack()),
-    p_stack(sass::vector<Statement*>())
+    p_stack(sass::vector<Statement*>()),
+    remove_placeholders(!ctx.c_options.legacy_passes),
+    placeholders()
   { }
 
   Statement* Cssize::parent()
@@ -123,9 +125,7 @@ namespace Sass {
     Block_Obj db = rr->block();
     if (db.isNull()) db = SASS_MEMORY_NEW(Block, rr->pstate());
     Block_Obj ss = debubble(db, rr);
-    for (size_t i = 0, L = ss->length(); i < L; ++i) {
-      result->append(ss->at(i));
-    }
+    result->concat(ss);
 
     return result;
   }
@@ -144,6 +144,10 @@ namespace Sass {
 
   Statement* Cssize::operator()(StyleRule* r)
   {
+    // every rule in the result shares the selector of one passing here
+    if (remove_placeholders && r->selector()) {
+      placeholders.remove_placeholders(r->selector());
+    }
     p_stack.push_back(r);
     // this can return a string schema
     // string schema is not a statement!
@@ -168,20 +172,19 @@ namespace Sass {
       error("Illegal nesting: Only properties may be nested beneath properties.", r->block()->pstate(), traces);
     }
 
-    Block_Obj props = SASS_MEMORY_NEW(Block, rr->block()->pstate());
-    Block* rules = SASS_MEMORY_NEW(Block, rr->block()->pstate());
-    for (size_t i = 0, L = rr->block()->length(); i < L; i++)
+    Block* children = rr->block();
+    Block_Obj props = SASS_MEMORY_NEW(Block, children->pstate());
+    Block_Obj rules = SASS_MEMORY_NEW(Block, children->pstate());
+    for (size_t i = 0, L = children->length(); i < L; i++)
     {
-      Statement* s = rr->block()->at(i);
+      Statement* s = children->at(i);
       if (bubblable(s)) rules->append(s);
-      if (!bubblable(s)) props->append(s);
+      else props->append(s);
     }
 
     if (props->length())
     {
-      Block_Obj pb = SASS_MEMORY_NEW(Block, rr->block()->pstate());
-      pb->concat(props);
-      rr->block(pb);
+      rr->block(props);
 
       for (size_t i = 0, L = rules->length(); i < L; i++)
       {
@@ -192,21 +195,15 @@ namespace Sass {
       rules->unshift(rr);
     }
 
-    Block* ptr = rules;
-    rules = debubble(rules);
-    void* lp = ptr;
-    void* rp = rules;
-    if (lp != rp) {
-      Block_Obj obj = ptr;
-    }
+    Block* result = debubble(rules);
 
-    if (!(!rules->length() ||
-          !bubblable(rules->last()) ||
+    if (!(!result->length() ||
+          !bubblable(result->last()) ||
           parent()->statement_type() == Statement::RULESET))
     {
-      rules->last()->group_end(true);
+      result->last()->group_end(true);
     }
-    return rules;
+    return result;
   }
 
   Statement* Cssize::operator()(Null* m)
@@ -331,7 +328,7 @@ namespace Sass {
 
   Statement* Cssize::bubble(SupportsRule* m)
   {
-    StyleRuleObj parent = Cast<StyleRule>(SASS_MEMORY_COPY(this->parent()));
+    StyleRule* parent = Cast<StyleRule>(this->parent());
 
     Block* bb = SASS_MEMORY_NEW(Block, parent->block()->pstate());
     StyleRule* new_rule = SASS_MEMORY_NEW(StyleRule,
@@ -356,7 +353,7 @@ namespace Sass {
 
   Statement* Cssize::bubble(CssMediaRule* m)
   {
-    StyleRuleObj parent = Cast<StyleRule>(SASS_MEMORY_COPY(this->parent()));
+    StyleRule* parent = Cast<StyleRule>(this->parent());
 
     Block* bb = SASS_MEMORY_NEW(Block, parent->block()->pstate());
     StyleRule* new_rule = SASS_MEMORY_NEW(StyleRule,
@@ -383,67 +380,41 @@ namespace Sass {
     return Cast<StyleRule>(s) || (s && s->bubbles());
   }
 
-  Block* Cssize::flatten(const Block* b)
+  // splice nested blocks into the result in place
+  void Cssize::append_flat(Block* result, Statement* s)
   {
-    Block* result = SASS_MEMORY_NEW(Block, b->pstate(), 0, b->is_root());
-    for (size_t i = 0, L = b->length(); i < L; ++i) {
-      Statement* ss = b->at(i);
-      if (const Block* bb = Cast<Block>(ss)) {
-        Block_Obj bs = flatten(bb);
-        for (size_t j = 0, K = bs->length(); j < K; ++j) {
-          result->append(bs->at(j));
-        }
-      }
-      else {
-        result->append(ss);
+    if (Block* b = Cast<Block>(s)) {
+      for (size_t i = 0, L = b->length(); i < L; ++i) {
+        append_flat(result, b->get(i));
       }
     }
-    return result;
-  }
-
-  sass::vector<std::pair<bool, Block_Obj>> Cssize::slice_by_bubble(Block* b)
-  {
-    sass::vector<std::pair<bool, Block_Obj>> results;
-
-    for (size_t i = 0, L = b->length(); i < L; ++i) {
-      Statement_Obj value = b->at(i);
-      bool key = Cast<Bubble>(value) != NULL;
-
-      if (!results.empty() && results.back().first == key)
-      {
-        Block_Obj wrapper_block = results.back().second;
-        wrapper_block->append(value);
-      }
-      else
-      {
-        Block* wrapper_block = SASS_MEMORY_NEW(Block, value->pstate());
-        wrapper_block->append(value);
-        results.push_back(std::make_pair(key, wrapper_block));
-      }
+    else {
+      result->append(s);
     }
-    return results;
   }
 
+  // children that did not bubble stay in copies of the parent,
+  // bubbled nodes are cssized and spliced in between those copies
   Block* Cssize::debubble(Block* children, Statement* parent)
   {
     ParentStatementObj previous_parent;
-    sass::vector<std::pair<bool, Block_Obj>> baz = slice_by_bubble(children);
-    Block_Obj result = SASS_MEMORY_NEW(Block, children->pstate());
+    Block_Obj result = SASS_MEMORY_NEW(Block, children->pstate(), children->length());
 
-    for (size_t i = 0, L = baz.size(); i < L; ++i) {
-      bool is_bubble = baz[i].first;
-      Block_Obj slice = baz[i].second;
+    for (size_t i = 0, L = children->length(); i < L; ++i) {
+      Statement* stm = children->get(i);
+      Bubble* node = Cast<Bubble>(stm);
 
-      if (!is_bubble) {
+      if (!node) {
         if (!parent) {
-          result->append(slice);
+          append_flat(result, stm);
         }
         else if (previous_parent) {
-          previous_parent->block()->concat(slice);
+          previous_parent->block()->append(stm);
         }
         else {
           previous_parent = SASS_MEMORY_COPY(parent);
-          previous_parent->block(slice);
+          previous_parent->block(SASS_MEMORY_NEW(Block, stm->pstate()));
+          previous_parent->block()->append(stm);
           previous_parent->tabs(parent->tabs());
 
           result->append(previous_parent);
@@ -451,56 +422,51 @@ namespace Sass {
         continue;
       }
 
-      for (size_t j = 0, K = slice->length(); j < K; ++j)
-      {
-        Statement_Obj ss;
-        Statement_Obj stm = slice->at(j);
-        // this has to go now here (too bad)
-        Bubble_Obj node = Cast<Bubble>(stm);
-
-        CssMediaRule* rule1 = NULL;
-        CssMediaRule* rule2 = NULL;
-        if (parent) rule1 = Cast<CssMediaRule>(parent);
-        if (node) rule2 = Cast<CssMediaRule>(node->node());
-        if (rule1 || rule2) {
-          ss = node->node();
-        }
-
-        ss = node->node();
-
-        if (!ss) {
-          continue;
-        }
-
-        ss->tabs(ss->tabs() + node->tabs());
-        ss->group_end(node->group_end());
+      Statement_Obj ss = node->node();
+      if (!ss) continue;
 
-        Block_Obj bb = SASS_MEMORY_NEW(Block,
-                                    children->pstate(),
-                                    children->length(),
-                                    children->is_root());
-        auto evaled = ss->perform(this);
-        if (evaled) bb->append(evaled);
+      ss->tabs(ss->tabs() + node->tabs());
+      ss->group_end(node->group_end());
 
-        Block_Obj wrapper_block = SASS_MEMORY_NEW(Block,
-                                              children->pstate(),
-                                              children->length(),
-                                              children->is_root());
+      size_t before = result->length();
+      Statement_Obj evaled = ss->perform(this);
+      if (evaled) append_flat(result, evaled);
 
-        Block* wrapper = flatten(bb);
-        wrapper_block->append(wrapper);
+      if (result->length() != before) {
+        previous_parent = {};
+      }
+    }
 
-        if (wrapper->length()) {
-          previous_parent = {};
-        }
+    return result.detach();
+  }
 
-        if (wrapper_block) {
-          result->append(wrapper_block);
+  // join media rules that follow each other and have equal queries;
+  // rules further apart keep their place, as the cascade depends on it
+  void Cssize::merge_media_queries(Block* b)
+  {
+    sass::vector<Statement_Obj>& children = b->elements();
+    CssMediaRuleObj joined;
+    size_t n = 0;
+    for (size_t i = 0, L = children.size(); i < L; ++i) {
+      CssMediaRule* media = Cast<CssMediaRule>(children[i]);
+      CssMediaRule* previous = n ? Cast<CssMediaRule>(children[n - 1]) : nullptr;
+      if (media && previous && media->block() && previous->block() && *media == *previous) {
+        // copy once per run, the rule may also appear elsewhere
+        if (joined.ptr() != previous) {
+          joined = SASS_MEMORY_COPY(previous);
+          joined->block(SASS_MEMORY_COPY(previous->block()));
+          children[n - 1] = joined;
         }
+        joined->block()->concat(media->block());
+        continue;
       }
+      children[n++] = children[i];
+    }
+    children.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      ParentStatement* parent = Cast<ParentStatement>(children[i]);
+      if (parent && parent->block()) merge_media_queries(parent->block());
     }
-
-    return flatten(result);
   }
 
   void Cssize::append_block(Block* b, Block* cur)
@@ -5,6 +5,7 @@
 #include "context.hpp"
 #include "operation.hpp"
 #include "environment.hpp"
+#include "remove_placeholders.hpp"
 
 namespace Sass {
 
@@ -15,6 +16,9 @@ namespace Sass {
     Backtraces&                 traces;
     BlockStack      block_stack;
     sass::vector<Statement*>  p_stack;
+    // unless done by a separate pass
+    bool                      remove_placeholders;
+    Remove_Placeholders       placeholders;
 
   public:
     Cssize(Context&);
@@ -48,14 +52,14 @@ namespace Sass {
     Statement* operator()(Null*);
 
     Statement* parent();
-    sass::vector<std::pair<bool, Block_Obj>> slice_by_bubble(Block*);
     Statement* bubble(AtRule*);
     Statement* bubble(AtRootRule*);
     Statement* bubble(CssMediaRule*);
     Statement* bubble(SupportsRule*);
 
     Block* debubble(Block* children, Statement* parent = 0);
-    Block* flatten(const Block*);
+    void append_flat(Block*, Statement*);
+    void merge_media_queries(Block*);
     bool bubblable(Statement*);
 
     // generic fallback
@@ -816,9 +816,9 @@ inline void debug_ast(AST_Node* node, sass::string ind, Env* env)
     std::cerr << " [interpolant: " << expression->is_interpolant() << "] ";
     std::cerr << " (" << pstate_source_position(node) << ")";
     std::cerr << " [Hashed]" << std::endl;
-    for (const auto& i : expression->elements()) {
-      debug_ast(i.first, ind + " key: ");
-      debug_ast(i.second, ind + " val: ");
+    for (const auto& key : expression->keys()) {
+      debug_ast(key, ind + " key: ");
+      debug_ast(expression->at(key), ind + " val: ");
     }
   } else if (Cast<List>(node)) {
     List* expression = Cast<List>(node);
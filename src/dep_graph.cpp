@@ -0,0 +1,124 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include "dep_graph.hpp"
+#include "context.hpp"
+#include "file.hpp"
+
+namespace Sass {
+
+  void DependencyGraph::erase(const sass::string& entry)
+  {
+    auto it = deps.find(entry);
+    if (it == deps.end()) return;
+    for (auto& dep : it->second) {
+      auto imp = importers.find(dep.first);
+      if (imp == importers.end()) continue;
+      imp->second.erase(entry);
+      if (imp->second.empty()) importers.erase(imp);
+    }
+    deps.erase(it);
+    auto dirs = missing_dirs.find(entry);
+    if (dirs == missing_dirs.end()) return;
+    for (const sass::string& dir : dirs->second) {
+      auto imp = dir_importers.find(dir);
+      if (imp == dir_importers.end()) continue;
+      imp->second.erase(entry);
+      if (imp->second.empty()) dir_importers.erase(imp);
+    }
+    missing_dirs.erase(dirs);
+  }
+
+  void DependencyGraph::record(const Context& ctx, bool success)
+  {
+    // nothing was loaded (e.g. input file not found)
+    if (ctx.included_files.empty()) return;
+    // included files and resources are pushed together
+    sass::string entry(File::rel2abs(ctx.included_files[0], ".", ctx.CWD));
+    std::unordered_map<sass::string, uint64_t> files;
+    for (size_t i = 0; i < ctx.included_files.size(); ++i) {
+      sass::string path(File::rel2abs(ctx.included_files[i], ".", ctx.CWD));
+      files[path] = File::digest(ctx.resources[i].contents);
+    }
+    // creating one of these may change how imports resolve
+    for (const sass::string& file : ctx.resolver_cache.missing_files()) {
+      files.emplace(File::rel2abs(file, ".", ctx.CWD), File::digest(nullptr));
+    }
+    std::unordered_set<sass::string> dirs;
+    for (const sass::string& dir : ctx.resolver_cache.missing_dirs()) {
+      dirs.insert(File::rel2abs(dir, ".", ctx.CWD));
+    }
+    record(entry, std::move(files), std::move(dirs), success);
+  }
+
+  void DependencyGraph::record(const sass::string& entry, std::unordered_map<sass::string, uint64_t> files,
+    std::unordered_set<sass::string> dirs, bool success)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    erase(entry);
+    for (auto& file : files) importers[file.first].insert(entry);
+    deps[entry] = std::move(files);
+    std::unordered_set<sass::string> paths;
+    // include paths are kept with a trailing slash
+    for (sass::string dir : dirs) {
+      while (dir.size() > 1 && dir.back() == '/') dir.pop_back();
+      dir_importers[dir].insert(entry);
+      paths.insert(std::move(dir));
+    }
+    if (!paths.empty()) missing_dirs[entry] = std::move(paths);
+    if (success) failed.erase(entry);
+    else failed.insert(entry);
+  }
+
+  void DependencyGraph::forget(const sass::string& entry)
+  {
+    sass::string path(File::rel2abs(entry));
+    std::lock_guard<std::mutex> lock(mutex);
+    failed.erase(path);
+    erase(path);
+  }
+
+  sass::vector<sass::string> DependencyGraph::affected(const sass::vector<sass::string>& changed) const
+  {
+    // read outside of the lock, a missing file
+    // is remembered with the digest of nothing
+    std::unordered_map<sass::string, uint64_t> current;
+    for (const sass::string& file : changed) {
+      sass::string path(File::rel2abs(file));
+      if (current.count(path)) continue;
+      char* contents = File::read_file(path);
+      current[path] = File::digest(contents);
+      free(contents);
+    }
+    std::unordered_set<sass::string> rebuild;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& file : current) {
+      // a new file inside a directory that was missing
+      if (file.second != File::digest(nullptr) && !dir_importers.empty()) {
+        sass::string dir(file.first);
+        for (size_t pos = dir.rfind('/'); pos != sass::string::npos && pos > 0; pos = dir.rfind('/')) {
+          dir.erase(pos);
+          auto imp = dir_importers.find(dir);
+          if (imp != dir_importers.end()) rebuild.insert(imp->second.begin(), imp->second.end());
+        }
+      }
+      auto imp = importers.find(file.first);
+      if (imp == importers.end()) continue;
+      for (const sass::string& entry : imp->second) {
+        // a broken entry must be retried on any change
+        if (failed.count(entry)) rebuild.insert(entry);
+        // skip files that were only touched
+        else if (deps.at(entry).at(file.first) != file.second) {
+          rebuild.insert(entry);
+        }
+      }
+    }
+    sass::vector<sass::string> entries(rebuild.begin(), rebuild.end());
+    std::sort(entries.begin(), entries.end());
+    return entries;
+  }
+
+}
@@ -0,0 +1,57 @@
+#ifndef SASS_DEP_GRAPH_H
+#define SASS_DEP_GRAPH_H
+
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include "sass/context.h"
+
+namespace Sass {
+
+  class Context;
+
+  // Remembers which files every entry point loaded during its
+  // last compilation, together with a digest of their contents.
+  // Import candidates that were looked up but not found are kept
+  // with the digest of a missing file, so creating one of them
+  // counts as a change. It outlives single compilations so a
+  // watcher can ask which entry points a set of changed files
+  // invalidates. Instances may be shared by compilations
+  // running on different threads.
+  class DependencyGraph {
+    private:
+      // entry point -> loaded or missing file -> content digest
+      std::unordered_map<sass::string, std::unordered_map<sass::string, uint64_t>> deps;
+      // loaded or missing file -> entry points that looked for it
+      std::unordered_map<sass::string, std::unordered_set<sass::string>> importers;
+      // entry point -> directories that were found to be missing
+      std::unordered_map<sass::string, std::unordered_set<sass::string>> missing_dirs;
+      // missing directory -> entry points that looked into it
+      std::unordered_map<sass::string, std::unordered_set<sass::string>> dir_importers;
+      // entry points whose last compilation failed
+      std::unordered_set<sass::string> failed;
+      mutable std::mutex mutex;
+      void erase(const sass::string& entry);
+    public:
+      // replace what we know about the compiled entry point
+      void record(const Context& ctx, bool success);
+      // same with absolute paths and their content digests
+      void record(const sass::string& entry, std::unordered_map<sass::string, uint64_t> files,
+        std::unordered_set<sass::string> dirs, bool success);
+      // drop an entry point that is no longer compiled
+      void forget(const sass::string& entry);
+      // entry points loading one of the changed files whose
+      // contents differ from what they have last compiled
+      sass::vector<sass::string> affected(const sass::vector<sass::string>& changed) const;
+  };
+
+}
+
+// opaque handle for the C-API
+struct Sass_Dependency_Graph : Sass::DependencyGraph { };
+
+#endif
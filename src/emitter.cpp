@@ -16,6 +16,7 @@ namespace Sass {
     scheduled_delimiter(false),
     scheduled_crutch(0),
     scheduled_mapping(0),
+    interrupt(nullptr),
     in_custom_property(false),
     in_comment(false),
     in_wrapped(false),
@@ -97,7 +98,8 @@ namespace Sass {
   void Emitter::prepend_output(const OutputBuffer& output)
   {
     wbuf.smap.prepend(output);
-    wbuf.buffer = output.buffer + wbuf.buffer;
+    // avoid copying the whole buffer if there is nothing to add
+    if (!output.buffer.empty()) wbuf.buffer.insert(0, output.buffer);
   }
 
   // prepend some text or token to the buffer
@@ -108,7 +110,7 @@ namespace Sass {
     if (text.compare("\xEF\xBB\xBF") != 0) {
       wbuf.smap.prepend(Offset(text));
     }
-    wbuf.buffer = text + wbuf.buffer;
+    wbuf.buffer.insert(0, text);
   }
 
   char Emitter::last_char()
@@ -8,6 +8,7 @@
 #include "sass/base.h"
 #include "source_map.hpp"
 #include "ast_fwd_decl.hpp"
+#include "interrupt.hpp"
 
 namespace Sass {
   class Context;
@@ -23,7 +24,7 @@ namespace Sass {
     public:
       const sass::string& buffer(void) { return wbuf.buffer; }
       const SourceMap smap(void) { return wbuf.smap; }
-      const OutputBuffer output(void) { return wbuf; }
+      const OutputBuffer& output(void) { return wbuf; }
       // proxy methods for source maps
       void add_source_index(size_t idx);
       void set_filename(const sass::string& str);
@@ -41,6 +42,8 @@ namespace Sass {
       bool scheduled_delimiter;
       const AST_Node* scheduled_crutch;
       const AST_Node* scheduled_mapping;
+      // polled per rule if set
+      Interrupt* interrupt;
 
     public:
       // output strings different in custom css properties
@@ -212,8 +212,9 @@ namespace Sass {
   {
     auto cur = this;
     while (cur) {
-      if (cur->has_local(key)) {
-        return cur->get_local(key);
+      auto it = cur->local_frame_.find(key);
+      if (it != cur->local_frame_.end()) {
+        return it->second;
       }
       cur = cur->parent_;
     }
@@ -224,14 +225,7 @@ namespace Sass {
   template <typename T>
   T& Environment<T>::operator[](const sass::string& key)
   {
-    auto cur = this;
-    while (cur) {
-      if (cur->has_local(key)) {
-        return cur->get_local(key);
-      }
-      cur = cur->parent_;
-    }
-    return get_local(key);
+    return get(key);
   }
 /*
   #ifdef DEBUG
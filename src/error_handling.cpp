@@ -11,6 +11,19 @@
 
 namespace Sass {
 
+  // messages written by this thread
+  static thread_local size_t warnings = 0;
+
+  void count_warning()
+  {
+    ++ warnings;
+  }
+
+  size_t warnings_written()
+  {
+    return warnings;
+  }
+
   namespace Exception {
 
     Base::Base(SourceSpan pstate, sass::string msg, Backtraces traces)
@@ -164,6 +177,7 @@ namespace Sass {
 
   void warn(sass::string msg, SourceSpan pstate)
   {
+    count_warning();
     std::cerr << "Warning: " << msg << std::endl;
   }
 
@@ -174,6 +188,7 @@ namespace Sass {
     sass::string rel_path(Sass::File::abs2rel(pstate.getPath(), cwd, cwd));
     sass::string output_path(Sass::File::path_for_console(rel_path, abs_path, pstate.getPath()));
 
+    count_warning();
     std::cerr << "WARNING on line " << pstate.getLine() << ", column " << pstate.getColumn() << " of " << output_path << ":" << std::endl;
     std::cerr << msg << std::endl << std::endl;
   }
@@ -190,6 +205,7 @@ namespace Sass {
     sass::string rel_path(Sass::File::abs2rel(pstate.getPath(), cwd, cwd));
     sass::string output_path(Sass::File::path_for_console(rel_path, abs_path, pstate.getPath()));
 
+    count_warning();
     std::cerr << "DEPRECATION WARNING: " << msg << std::endl;
     std::cerr << "will be an error in future versions of Sass." << std::endl;
     std::cerr << "        on line " << pstate.getLine() << " of " << output_path << std::endl;
@@ -202,6 +218,7 @@ namespace Sass {
     sass::string rel_path(Sass::File::abs2rel(pstate.getPath(), cwd, cwd));
     sass::string output_path(Sass::File::path_for_console(rel_path, pstate.getPath(), pstate.getPath()));
 
+    count_warning();
     std::cerr << "DEPRECATION WARNING on line " << pstate.getLine();
     // if (with_column) std::cerr << ", column " << pstate.column + pstate.offset.column + 1;
     if (output_path.length()) std::cerr << " of " << output_path;
@@ -218,6 +235,7 @@ namespace Sass {
     sass::string rel_path(Sass::File::abs2rel(pstate.getPath(), cwd, cwd));
     sass::string output_path(Sass::File::path_for_console(rel_path, abs_path, pstate.getPath()));
 
+    count_warning();
     std::cerr << "WARNING: " << msg << std::endl;
     std::cerr << "        on line " << pstate.getLine() << " of " << output_path << std::endl;
     std::cerr << "This will be an error in future versions of Sass." << std::endl;
@@ -236,4 +254,11 @@ namespace Sass {
     throw Exception::InvalidSyntax(pstate, traces, msg);
   }
 
+  // for callers that only borrow the stack
+  void error(sass::string msg, SourceSpan pstate, const Backtraces& traces)
+  {
+    Backtraces copy(traces);
+    error(msg, pstate, copy);
+  }
+
 }
@@ -157,6 +157,24 @@ namespace Sass {
         virtual ~OperationError() throw() {};
     };
 
+    /* the compile was stopped from outside (has no pstate or trace) */
+    class Interrupted : public std::runtime_error {
+      public:
+        Interrupted(sass::string msg)
+        : std::runtime_error(msg.c_str())
+        {};
+        virtual ~Interrupted() throw() {};
+    };
+
+    /* the compile ran out of a budget (has no pstate or trace) */
+    class BudgetExceeded : public std::runtime_error {
+      public:
+        BudgetExceeded(sass::string msg)
+        : std::runtime_error(msg.c_str())
+        {};
+        virtual ~BudgetExceeded() throw() {};
+    };
+
     class ZeroDivisionError : public OperationError {
       protected:
         const Expression& lhs;
@@ -231,6 +249,11 @@ namespace Sass {
 
   }
 
+  // warnings and debug messages written by this thread, so
+  // a compilation can tell if it printed anything
+  void count_warning();
+  size_t warnings_written();
+
   void warn(sass::string msg, SourceSpan pstate);
   void warn(sass::string msg, SourceSpan pstate, Backtrace* bt);
   void warning(sass::string msg, SourceSpan pstate);
@@ -242,6 +265,7 @@ namespace Sass {
 
   void coreError(sass::string msg, SourceSpan pstate);
   void error(sass::string msg, SourceSpan pstate, Backtraces& traces);
+  void error(sass::string msg, SourceSpan pstate, const Backtraces& traces);
 
 }
 
@@ -172,6 +172,50 @@ namespace Sass {
     return rv.detach();
   }
 
+  // the old value is released from the slot first, so only
+  // a reference kept by the loop body (e.g. in a list) or by
+  // the output makes the loop variable shared
+  void Eval::loop_number(Number_Obj& it, AST_Node_Obj& slot, const Number* proto, double value)
+  {
+    slot = {};
+    if (it && !it->isShared()) {
+      // undo what evaluating the body may have changed
+      it->numerators = proto->numerators;
+      it->denominators = proto->denominators;
+      it->zero(proto->zero());
+      it->is_delayed(proto->is_delayed());
+      it->is_expanded(proto->is_expanded());
+      it->is_interpolant(proto->is_interpolant());
+    }
+    else {
+      it = SASS_MEMORY_COPY(proto);
+    }
+    it->value(value);
+    slot = it;
+  }
+
+  void Eval::loop_pair(List_Obj& pair, AST_Node_Obj& slot, const SourceSpan& pstate, Expression* key, Expression* value)
+  {
+    slot = {};
+    if (pair && !pair->isShared()) {
+      pair->clear();
+      pair->separator(SASS_SPACE);
+      pair->is_arglist(false);
+      pair->is_bracketed(false);
+      pair->from_selector(false);
+      pair->is_delayed(false);
+      pair->is_interpolant(false);
+    }
+    else {
+      pair = SASS_MEMORY_NEW(List, pstate, 2, SASS_SPACE);
+    }
+    pair->append(key);
+    pair->append(value);
+    // key and value are evaluated already
+    pair->is_expanded(true);
+    slot = pair;
+  }
+
   // For does not create a new env scope
   // But iteration vars are reset afterwards
   Expression* Eval::operator()(ForRule* f)
@@ -203,13 +247,17 @@ namespace Sass {
     env_stack().push_back(&env);
     Block_Obj body = f->block();
     Expression* val = 0;
+    // the unit is only parsed once
+    Number_Obj proto = SASS_MEMORY_NEW(Number, low->pstate(), start, sass_end->unit());
+    Number_Obj it;
+    AST_Node_Obj& slot = env.get_local(variable);
     if (start < end) {
       if (f->is_inclusive()) ++end;
       for (double i = start;
            i < end;
            ++i) {
-        Number_Obj it = SASS_MEMORY_NEW(Number, low->pstate(), i, sass_end->unit());
-        env.set_local(variable, it);
+        ctx.interrupt.poll();
+        loop_number(it, slot, proto, i);
         val = body->perform(this);
         if (val) break;
       }
@@ -218,8 +266,8 @@ namespace Sass {
       for (double i = start;
            i > end;
            --i) {
-        Number_Obj it = SASS_MEMORY_NEW(Number, low->pstate(), i, sass_end->unit());
-        env.set_local(variable, it);
+        ctx.interrupt.poll();
+        loop_number(it, slot, proto, i);
         val = body->perform(this);
         if (val) break;
       }
@@ -257,17 +305,19 @@ namespace Sass {
     ExpressionObj val;
 
     if (map) {
-      for (ExpressionObj key : map->keys()) {
-        ExpressionObj value = map->at(key);
-
-        if (variables.size() == 1) {
-          List* variable = SASS_MEMORY_NEW(List, map->pstate(), 2, SASS_SPACE);
-          variable->append(key);
-          variable->append(value);
-          env.set_local(variables[0], variable);
+      List_Obj pair;
+      // bind the variables once, frame references stay valid
+      AST_Node_Obj& slot = env.get_local(variables[0]);
+      AST_Node_Obj* value_slot = variables.size() > 1 ? &env.get_local(variables[1]) : nullptr;
+      const sass::vector<ExpressionObj>& keys(map->keys());
+      const sass::vector<ExpressionObj>& values(map->values());
+      for (size_t i = 0, L = keys.size(); i < L; ++i) {
+        ctx.interrupt.poll();
+        if (value_slot == nullptr) {
+          loop_pair(pair, slot, map->pstate(), keys[i], values[i]);
         } else {
-          env.set_local(variables[0], key);
-          env.set_local(variables[1], value);
+          slot = keys[i];
+          *value_slot = values[i];
         }
 
         val = body->perform(this);
@@ -279,6 +329,7 @@ namespace Sass {
         list = Cast<List>(list);
       }
       for (size_t i = 0, L = list->length(); i < L; ++i) {
+        ctx.interrupt.poll();
         Expression* item = list->at(i);
         // unwrap value if the expression is an argument
         if (Argument* arg = Cast<Argument>(item)) item = arg->value();
@@ -320,6 +371,7 @@ namespace Sass {
     env_stack().push_back(&env);
     ExpressionObj cond = pred->perform(this);
     while (!cond->is_false()) {
+      ctx.interrupt.poll();
       ExpressionObj val = body->perform(this);
       if (val) {
         env_stack().pop_back();
@@ -341,6 +393,8 @@ namespace Sass {
     Sass_Output_Style outstyle = options().output_style;
     options().output_style = NESTED;
     ExpressionObj message = w->message()->perform(this);
+    // also when it is handed to a custom function
+    count_warning();
     Env* env = environment();
 
     // try to use generic function
@@ -433,6 +487,7 @@ namespace Sass {
     Sass_Output_Style outstyle = options().output_style;
     options().output_style = NESTED;
     ExpressionObj message = d->value()->perform(this);
+    count_warning();
     Env* env = environment();
 
     // try to use generic function
@@ -906,11 +961,13 @@ namespace Sass {
       result->value(!result->value());
       return result;
     }
-    else if (Number_Obj nr = Cast<Number>(operand)) {
+    else if (Number* nr = Cast<Number>(operand)) {
       // negate value for minus unary expression
       if (u->optype() == Unary_Expression::MINUS) {
-        Number_Obj cpy = SASS_MEMORY_COPY(nr);
+        // only copy if the number is referenced elsewhere
+        Number_Obj cpy = SASS_MEMORY_COW(nr);
         cpy->value( - cpy->value() ); // negate value
+        operand = {}; // release before detaching
         return cpy.detach(); // return the copy
       }
       else if (u->optype() == Unary_Expression::SLASH) {
@@ -918,7 +975,7 @@ namespace Sass {
         return SASS_MEMORY_NEW(String_Constant, u->pstate(), str);
       }
       // nothing for positive
-      return nr.detach();
+      return operand.detach();
     }
     else {
       // Special cases: +/- variables which evaluate to null output just +/-,
@@ -953,6 +1010,22 @@ namespace Sass {
     return u;
   }
 
+  // strings are appended as inspect would render
+  // them, without setting up an emitter for them
+  static void append_to_string(sass::string& res, Expression* ex, Sass_Inspect_Options opt)
+  {
+    if (String_Quoted* str = Cast<String_Quoted>(ex)) {
+      if (str->quote_mark()) res += quote(str->value(), str->quote_mark());
+      else res += str->value();
+    }
+    else if (String_Constant* str = Cast<String_Constant>(ex)) {
+      res += str->value();
+    }
+    else {
+      res += ex->to_string(opt);
+    }
+  }
+
   Expression* Eval::operator()(Function_Call* c)
   {
     if (traces.size() > Constants::MaxCallStack) {
@@ -965,7 +1038,8 @@ namespace Sass {
     if (Cast<String_Schema>(c->sname())) {
       ExpressionObj evaluated_name = c->sname()->perform(this);
       ExpressionObj evaluated_args = c->arguments()->perform(this);
-      sass::string str(evaluated_name->to_string());
+      sass::string str;
+      append_to_string(str, evaluated_name, { NESTED, 5 });
       str += evaluated_args->to_string();
       return SASS_MEMORY_NEW(String_Constant, c->pstate(), str);
     }
@@ -977,8 +1051,11 @@ namespace Sass {
     Arguments_Obj args = c->arguments();
 
     Env* env = environment();
-    if (!env->has(full_name) || (!c->via_call() && Prelexer::re_special_fun(name.c_str()))) {
-      if (!env->has("*[f]")) {
+    // resolve the function with a single lookup
+    EnvResult fn(env->find(full_name));
+    if (!fn.found || (!c->via_call() && Prelexer::re_special_fun(name.c_str()))) {
+      fn = env->find("*[f]");
+      if (!fn.found) {
         for (Argument_Obj arg : args->elements()) {
           if (List_Obj ls = Cast<List>(arg->value())) {
             if (ls->size() == 0) error("() isn't a valid CSS value.", c->pstate(), traces);
@@ -1003,6 +1080,9 @@ namespace Sass {
       }
     }
 
+    // get it before evaluating the arguments
+    Definition* def = Cast<Definition>(fn.it->second);
+
     // further delay for calls
     if (full_name != "call[f]") {
       args->set_delayed(false); // verified
@@ -1010,7 +1090,6 @@ namespace Sass {
     if (full_name != "if[f]") {
       args = Cast<Arguments>(args->perform(this));
     }
-    Definition* def = Cast<Definition>((*env)[full_name]);
 
     if (c->func()) def = c->func()->definition();
 
@@ -1026,9 +1105,9 @@ namespace Sass {
       }
       ss << full_name << L;
       full_name = ss.str();
-      sass::string resolved_name(full_name);
-      if (!env->has(resolved_name)) error("overloaded function `" + sass::string(c->name()) + "` given wrong number of arguments", c->pstate(), traces);
-      def = Cast<Definition>((*env)[resolved_name]);
+      EnvResult overload(env->find(full_name));
+      if (!overload.found) error("overloaded function `" + sass::string(c->name()) + "` given wrong number of arguments", c->pstate(), traces);
+      def = Cast<Definition>(overload.it->second);
     }
 
     ExpressionObj     result = c;
@@ -1044,8 +1123,7 @@ namespace Sass {
 
     if (func || body) {
       bind(sass::string("Function"), c->name(), params, args, &fn_env, this, traces);
-      sass::string msg(", in function `" + c->name() + "`");
-      traces.push_back(Backtrace(c->pstate(), msg));
+      traces.push_back(Backtrace(c->pstate(), Backtrace::FUNCTION, c->name()));
       callee_stack().push_back({
         c->name().c_str(),
         c->pstate().getPath(),
@@ -1082,10 +1160,8 @@ namespace Sass {
       }
 
       // populates env with default values for params
-      sass::string ff(c->name());
       bind(sass::string("Function"), c->name(), params, args, &fn_env, this, traces);
-      sass::string msg(", in function `" + c->name() + "`");
-      traces.push_back(Backtrace(c->pstate(), msg));
+      traces.push_back(Backtrace(c->pstate(), Backtrace::FUNCTION, c->name()));
       callee_stack().push_back({
         c->name().c_str(),
         c->pstate().getPath(),
@@ -1142,15 +1218,17 @@ namespace Sass {
     Env* env = environment();
     const sass::string& name(v->name());
     EnvResult rv(env->find(name));
-    if (rv.found) value = static_cast<Expression*>(rv.it->second.ptr());
-    else error("Undefined variable: \"" + v->name() + "\".", v->pstate(), traces);
+    if (!rv.found) error("Undefined variable: \"" + v->name() + "\".", v->pstate(), traces);
+    // references stay valid even if the frame is rehashed
+    AST_Node_Obj& slot = rv.it->second;
+    value = static_cast<Expression*>(slot.ptr());
     if (Argument* arg = Cast<Argument>(value)) value = arg->value();
     if (Number* nr = Cast<Number>(value)) nr->zero(true); // force flag
     value->is_interpolant(v->is_interpolant());
     if (force) value->is_expanded(false);
     value->set_delayed(false); // verified
     value = value->perform(this);
-    if(!force) rv.it->second = value;
+    if(!force) slot = value;
     return value.detach();
   }
 
@@ -1199,13 +1277,8 @@ namespace Sass {
     if (Argument* arg = Cast<Argument>(ex)) {
       ex = arg->value();
     }
-    if (String_Quoted* sq = Cast<String_Quoted>(ex)) {
-      if (was_itpl) {
-        bool was_interpolant = ex->is_interpolant();
-        ex = SASS_MEMORY_NEW(String_Constant, sq->pstate(), sq->value());
-        ex->is_interpolant(was_interpolant);
-      }
-    }
+    // interpolated quoted strings lose their quotes
+    String_Quoted* unquoted = was_itpl ? Cast<String_Quoted>(ex) : nullptr;
 
     if (Cast<Null>(ex)) { return; }
 
@@ -1215,7 +1288,22 @@ namespace Sass {
       ex = ex->perform(this);
     }
 
-    if (List* l = Cast<List>(ex)) {
+    // every interpolant is wrapped in a list with one item, which
+    // renders like that item (without an emitter for the list)
+    List* l = Cast<List>(ex);
+    if (l && l->length() == 1 && options().output_style != TO_SASS) {
+      ExpressionObj item = l->at(0);
+      item->is_interpolant(l->is_interpolant());
+      sass::string rl(""); interpolation(ctx, rl, item, into_quotes, l->is_interpolant());
+      if (!Cast<Null>(item)) {
+        // same as rendering a String_Quoted made from it
+        char quote_mark = 0;
+        sass::string value(unquote(read_css_string(rl, true), &quote_mark));
+        res += quote_mark ? quote(value, quote_mark) : value;
+      }
+    }
+
+    else if (l) {
       List_Obj ll = SASS_MEMORY_NEW(List, l->pstate(), 0, l->separator());
       // this fixes an issue with bourbon sample, not really sure why
       // if (l->size() && Cast<Null>((*l)[0])) { res += ""; }
@@ -1247,13 +1335,16 @@ namespace Sass {
     // Binary_Expression
     else {
       // ex = ex->perform(this);
-      if (into_quotes && ex->is_interpolant()) {
-        res += evacuate_escapes(ex ? ex->to_string(options()) : "");
-      } else {
-        sass::string str(ex ? ex->to_string(options()) : "");
-        if (into_quotes) str = read_hex_escapes(str);
-        res += str; // append to result string
+      if (into_quotes) {
+        sass::string str;
+        if (unquoted) str = read_css_string(unquoted->value(), true);
+        else if (ex) append_to_string(str, ex, options());
+        if (ex->is_interpolant()) res += evacuate_escapes(str);
+        else res += read_hex_escapes(str);
       }
+      // append to result string
+      else if (unquoted) res += read_css_string(unquoted->value(), true);
+      else if (ex) append_to_string(res, ex, options());
     }
 
     if (needs_closing_brace) res += ")";
@@ -1279,11 +1370,20 @@ namespace Sass {
     bool was_quoted = false;
     bool was_interpolant = false;
     sass::string res("");
+    // literal parts usually make up most of the result
+    size_t estimate = 0;
+    for (size_t i = 0; i < L; ++i) {
+      String_Constant* str = Cast<String_Constant>((*s)[i]);
+      estimate += str ? str->value().size() : 16;
+    }
+    res.reserve(estimate);
     for (size_t i = 0; i < L; ++i) {
       bool is_quoted = Cast<String_Quoted>((*s)[i]) != NULL;
       if (was_quoted && !(*s)[i]->is_interpolant() && !was_interpolant) { res += " "; }
       else if (i > 0 && is_quoted && !(*s)[i]->is_interpolant() && !was_interpolant) { res += " "; }
-      ExpressionObj ex = (*s)[i]->perform(this);
+      // strings evaluate to themselves (or an equal copy)
+      ExpressionObj ex = (*s)[i];
+      if (!Cast<String_Constant>(ex)) ex = ex->perform(this);
       interpolation(ctx, res, ex, into_quotes, ex->is_interpolant());
       was_quoted = Cast<String_Quoted>((*s)[i]) != NULL;
       was_interpolant = (*s)[i]->is_interpolant();
@@ -1291,11 +1391,11 @@ namespace Sass {
     }
     if (!s->is_interpolant()) {
       if (s->length() > 1 && res == "") return SASS_MEMORY_NEW(Null, s->pstate());
-      String_Constant_Obj str = SASS_MEMORY_NEW(String_Constant, s->pstate(), res, s->css());
+      String_Constant_Obj str = SASS_MEMORY_NEW(String_Constant, s->pstate(), std::move(res), s->css());
       return str.detach();
     }
     // string schema seems to have a special unquoting behavior (also handles "nested" quotes)
-    String_Quoted_Obj str = SASS_MEMORY_NEW(String_Quoted, s->pstate(), res, 0, false, false, false, s->css());
+    String_Quoted_Obj str = SASS_MEMORY_NEW(String_Quoted, s->pstate(), std::move(res), 0, false, false, false, s->css());
     // if (s->is_interpolant()) str->quote_mark(0);
     // String_Constant* str = SASS_MEMORY_NEW(String_Constant, s->pstate(), res);
     if (str->quote_mark()) str->quote_mark('*');
@@ -1314,6 +1414,7 @@ namespace Sass {
   {
     String_Quoted* str = SASS_MEMORY_NEW(String_Quoted, s->pstate(), "");
     str->value(s->value());
+    str->share_code_points(s);
     str->quote_mark(s->quote_mark());
     str->is_interpolant(s->is_interpolant());
     return str;
@@ -1509,6 +1610,14 @@ namespace Sass {
     ExpressionObj sel = s->contents()->perform(this);
     sass::string result_str(sel->to_string(options()));
     result_str = unquote(Util::rtrim(result_str));
+    // rules in mixins often produce the same text again, while loops
+    // mostly produce new ones; callers get a clone, as resolving
+    // parent references alters it
+    auto& parsed_texts = ctx.parsed_selectors[s];
+    auto cached = parsed_texts.find(result_str);
+    if (cached != parsed_texts.end() && cached->second) {
+      return SASS_MEMORY_CLONE(cached->second);
+    }
     ItplFile* source = SASS_MEMORY_NEW(ItplFile,
       result_str.c_str(), s->pstate());
     Parser p(source, ctx, traces);
@@ -1517,6 +1626,14 @@ namespace Sass {
     // connected to it, so don't connect implicitly anymore
     SelectorListObj parsed = p.parseSelectorList(true);
     flag_is_in_selector_schema.reset();
+    // only keep a copy once the text repeats, and only
+    // track the first few texts of each schema
+    if (cached != parsed_texts.end()) {
+      cached->second = SASS_MEMORY_CLONE(parsed);
+    }
+    else if (parsed_texts.size() < 16) {
+      parsed_texts.emplace(result_str, SelectorListObj());
+    }
     return parsed.detach();
   }
 
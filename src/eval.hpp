@@ -39,6 +39,11 @@ namespace Sass {
     struct Sass_Inspect_Options& options();
     struct Sass_Compiler* compiler();
 
+    // loop variables are updated in place as long
+    // as the loop body kept no reference to them
+    static void loop_number(Number_Obj& it, AST_Node_Obj& slot, const Number* proto, double value);
+    static void loop_pair(List_Obj& pair, AST_Node_Obj& slot, const SourceSpan& pstate, Expression* key, Expression* value);
+
     // for evaluating function bodies
     Expression* operator()(Block*);
     Expression* operator()(Assignment*);
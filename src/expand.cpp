@@ -28,6 +28,8 @@ namespace Sass {
     in_keyframes(false),
     at_root_without_rule(false),
     old_at_root_without_rule(false),
+    nesting_parent(nullptr),
+    nesting_suspect(false),
     env_stack(),
     block_stack(),
     call_stack(),
@@ -166,6 +168,8 @@ namespace Sass {
   Statement* Expand::operator()(StyleRule* r)
   {
     LOCAL_FLAG(old_at_root_without_rule, at_root_without_rule);
+    check_nesting(r);
+    LocalOption<Statement*> nesting(nesting_parent, r);
 
     if (in_keyframes) {
       Block* bb = operator()(r->block());
@@ -231,6 +235,8 @@ namespace Sass {
 
   Statement* Expand::operator()(SupportsRule* f)
   {
+    check_nesting(f);
+    LocalOption<Statement*> nesting(nesting_parent, f);
     ExpressionObj condition = f->condition()->perform(&eval);
     SupportsRuleObj ff = SASS_MEMORY_NEW(SupportsRule,
                                        f->pstate(),
@@ -257,6 +263,8 @@ namespace Sass {
 
   Statement* Expand::operator()(MediaRule* m)
   {
+    check_nesting(m);
+    LocalOption<Statement*> nesting(nesting_parent, m);
     ExpressionObj mq = eval(m->schema());
     sass::string str_mq(mq->to_css(ctx.c_options));
     ItplFile* source = SASS_MEMORY_NEW(ItplFile,
@@ -281,6 +289,8 @@ namespace Sass {
 
   Statement* Expand::operator()(AtRootRule* a)
   {
+    check_nesting(a);
+    LocalOption<Statement*> nesting(nesting_parent, a);
     Block_Obj ab = a->block();
     ExpressionObj ae = a->expression();
 
@@ -302,6 +312,8 @@ namespace Sass {
 
   Statement* Expand::operator()(AtRule* a)
   {
+    check_nesting(a);
+    LocalOption<Statement*> nesting(nesting_parent, a);
     LOCAL_FLAG(in_keyframes, a->is_keyframes());
     Block* ab = a->block();
     SelectorList* as = a->selector();
@@ -333,7 +345,9 @@ namespace Sass {
     }
     ExpressionObj value = d->value();
     if (value) value = value->perform(&eval);
+    LocalOption<Statement*> nesting(nesting_parent, d);
     Block_Obj bb = ab ? operator()(ab) : NULL;
+    nesting.reset();
     if (!bb) {
       if (!value || (value->is_invisible() && !d->is_important())) {
         if (d->is_custom_property()) {
@@ -351,6 +365,7 @@ namespace Sass {
                                         d->is_custom_property(),
                                         bb);
     decl->tabs(d->tabs());
+    check_nesting(decl);
     return decl;
   }
 
@@ -423,6 +438,7 @@ namespace Sass {
 
   Statement* Expand::operator()(Import* imp)
   {
+    check_nesting(imp);
     Import_Obj result = SASS_MEMORY_NEW(Import, imp->pstate());
     if (imp->import_queries() && imp->import_queries()->size()) {
       ExpressionObj ex = imp->import_queries()->perform(&eval);
@@ -550,13 +566,17 @@ namespace Sass {
     env_stack.push_back(&env);
     call_stack.push_back(f);
     Block* body = f->block();
+    // the unit is only parsed once
+    Number_Obj proto = SASS_MEMORY_NEW(Number, low->pstate(), start, sass_end->unit());
+    Number_Obj it;
+    AST_Node_Obj& slot = env.get_local(variable);
     if (start < end) {
       if (f->is_inclusive()) ++end;
       for (double i = start;
            i < end;
            ++i) {
-        Number_Obj it = SASS_MEMORY_NEW(Number, low->pstate(), i, sass_end->unit());
-        env.set_local(variable, it);
+        ctx.interrupt.poll();
+        Eval::loop_number(it, slot, proto, i);
         append_block(body);
       }
     } else {
@@ -564,8 +584,8 @@ namespace Sass {
       for (double i = start;
            i > end;
            --i) {
-        Number_Obj it = SASS_MEMORY_NEW(Number, low->pstate(), i, sass_end->unit());
-        env.set_local(variable, it);
+        ctx.interrupt.poll();
+        Eval::loop_number(it, slot, proto, i);
         append_block(body);
       }
     }
@@ -603,18 +623,20 @@ namespace Sass {
     Block* body = e->block();
 
     if (map) {
-      for (auto key : map->keys()) {
-        ExpressionObj k = key->perform(&eval);
-        ExpressionObj v = map->at(key)->perform(&eval);
-
-        if (variables.size() == 1) {
-          List_Obj variable = SASS_MEMORY_NEW(List, map->pstate(), 2, SASS_SPACE);
-          variable->append(k);
-          variable->append(v);
-          env.set_local(variables[0], variable);
+      List_Obj pair;
+      // keys and values of the evaluated map are final, and
+      // the variables are bound once (frame references stay valid)
+      AST_Node_Obj& slot = env.get_local(variables[0]);
+      AST_Node_Obj* value_slot = variables.size() > 1 ? &env.get_local(variables[1]) : nullptr;
+      const sass::vector<ExpressionObj>& keys(map->keys());
+      const sass::vector<ExpressionObj>& values(map->values());
+      for (size_t i = 0, L = keys.size(); i < L; ++i) {
+        ctx.interrupt.poll();
+        if (value_slot == nullptr) {
+          Eval::loop_pair(pair, slot, map->pstate(), keys[i], values[i]);
         } else {
-          env.set_local(variables[0], k);
-          env.set_local(variables[1], v);
+          slot = keys[i];
+          *value_slot = values[i];
         }
         append_block(body);
       }
@@ -625,6 +647,7 @@ namespace Sass {
         list = Cast<List>(list);
       }
       for (size_t i = 0, L = list->length(); i < L; ++i) {
+        ctx.interrupt.poll();
         ExpressionObj item = list->at(i);
         // unwrap value if the expression is an argument
         if (Argument_Obj arg = Cast<Argument>(item)) item = arg->value();
@@ -667,6 +690,7 @@ namespace Sass {
     call_stack.push_back(w);
     ExpressionObj cond = pred->perform(&eval);
     while (!cond->is_false()) {
+      ctx.interrupt.poll();
       append_block(body);
       cond = pred->perform(&eval);
     }
@@ -776,10 +800,12 @@ namespace Sass {
 
     Env* env = environment();
     sass::string full_name(c->name() + "[m]");
-    if (!env->has(full_name)) {
+    // resolve the mixin with a single lookup
+    EnvResult mixin(env->find(full_name));
+    if (!mixin.found) {
       error("no mixin named " + c->name(), c->pstate(), traces);
     }
-    Definition_Obj def = Cast<Definition>((*env)[full_name]);
+    Definition_Obj def = Cast<Definition>(mixin.it->second);
     Block_Obj body = def->block();
     Parameters_Obj params = def->parameters();
 
@@ -788,8 +814,7 @@ namespace Sass {
     }
     ExpressionObj rv = c->arguments()->perform(&eval);
     Arguments_Obj args = Cast<Arguments>(rv);
-    sass::string msg(", in mixin `" + c->name() + "`");
-    traces.push_back(Backtrace(c->pstate(), msg));
+    traces.push_back(Backtrace(c->pstate(), Backtrace::MIXIN, c->name()));
     ctx.callee_stack.push_back({
       c->name().c_str(),
       c->pstate().getPath(),
@@ -860,12 +885,35 @@ namespace Sass {
     return trace.detach();
   }
 
+  // Flags what CheckNesting may reject in the expanded tree, so
+  // the compile only needs to run it when something was flagged.
+  // Statements are checked against the node that will hold their
+  // expansion, skipping mixin traces, which never count as parents.
+  // Blocks as statements and @at-root change how the parent is
+  // found, so anything below them is flagged if it may be wrong.
+  void Expand::check_nesting(Statement* node)
+  {
+    if (Declaration* d = Cast<Declaration>(node)) {
+      if (!nesting_parent || Cast<AtRootRule>(nesting_parent)) nesting_suspect = true;
+      if (Cast<Map>(d->value())) nesting_suspect = true;
+      Number* n = Cast<Number>(d->value());
+      if (n && !n->is_valid_css_unit()) nesting_suspect = true;
+    }
+    else if (Cast<Declaration>(nesting_parent)) {
+      nesting_suspect = true;
+    }
+    AtRule* r = Cast<AtRule>(node);
+    if (r && r->keyword() == "charset") nesting_suspect = true;
+  }
+
   // process and add to last block on stack
   inline void Expand::append_block(Block* b)
   {
     if (b->is_root()) call_stack.push_back(b);
     for (size_t i = 0, L = b->length(); i < L; ++i) {
+      ctx.interrupt.poll();
       Statement* stm = b->at(i);
+      if (Cast<Block>(stm)) nesting_suspect = true;
       Statement_Obj ith = stm->perform(this);
       if (ith) block_stack.back()->append(ith);
     }
@@ -39,6 +39,11 @@ namespace Sass {
     bool              in_keyframes;
     bool              at_root_without_rule;
     bool              old_at_root_without_rule;
+    // the node whose expansion receives the current statements,
+    // mixin calls and control directives leave it untouched
+    Statement*        nesting_parent;
+    // whether the result may break nesting rules
+    bool              nesting_suspect;
 
     // it's easier to work with vectors
     EnvStack      env_stack;
@@ -54,6 +59,7 @@ namespace Sass {
 
   private:
 
+    void check_nesting(Statement*);
     sass::vector<CssMediaQuery_Obj> mergeMediaQueries(const sass::vector<CssMediaQuery_Obj>& lhs, const sass::vector<CssMediaQuery_Obj>& rhs);
 
   public:
@@ -21,7 +21,8 @@ namespace Sass {
     extensionsByExtender(),
     mediaContexts(),
     sourceSpecificity(),
-    originals()
+    originals(),
+    interrupt(nullptr)
   {}
 
   // ##########################################################################
@@ -36,7 +37,8 @@ namespace Sass {
     extensionsByExtender(),
     mediaContexts(),
     sourceSpecificity(),
-    originals()
+    originals(),
+    interrupt(nullptr)
   {}
 
   // ##########################################################################
@@ -506,6 +508,7 @@ namespace Sass {
     // This could be written more simply using [List.map], but we want to
     // avoid any allocations in the common case where no extends apply.
     sass::vector<ComplexSelectorObj> extended;
+    size_t budget = interrupt ? interrupt->permutation_budget() : 0;
     for (size_t i = 0; i < list->length(); i++) {
       const ComplexSelectorObj& complex = list->get(i);
       sass::vector<ComplexSelectorObj> result =
@@ -524,6 +527,10 @@ namespace Sass {
         for (auto sel : result) {
           extended.push_back(sel);
         }
+        // the list grows with every extend that applies to it
+        if (budget && extended.size() > budget) {
+          permutationsExceeded(complex, budget);
+        }
       }
     }
 
@@ -611,18 +618,30 @@ namespace Sass {
 
     bool first = true;
 
+    // refuse to create more paths than allowed
+    size_t budget = interrupt ? interrupt->permutation_budget() : 0;
+    if (budget && countPermutations(extendedNotExpanded, budget) > budget) {
+      permutationsExceeded(complex, budget);
+    }
+
     // ToDo: either change weave or paths to work with the same data?
     sass::vector<sass::vector<ComplexSelectorObj>>
       paths = permutate(extendedNotExpanded);
 
     for (const sass::vector<ComplexSelectorObj>& path : paths) {
+      // weaving may take long for many paths
+      if (interrupt) interrupt->poll();
       // Unpack the inner complex selector to component list
       sass::vector<sass::vector<SelectorComponentObj>> _paths;
       for (const ComplexSelectorObj& sel : path) {
         _paths.insert(_paths.end(), sel->elements());
       }
 
-      sass::vector<sass::vector<SelectorComponentObj>> weaved = weave(_paths);
+      sass::vector<sass::vector<SelectorComponentObj>> weaved;
+      try { weaved = weave(_paths, budget); }
+      catch (Exception::BudgetExceeded&) {
+        permutationsExceeded(complex, budget);
+      }
 
       for (sass::vector<SelectorComponentObj>& components : weaved) {
 
@@ -1223,4 +1242,18 @@ namespace Sass {
   }
   // hasMoreThanOne
 
+  // ##########################################################################
+  // Throws when extending [complex] needs more permutations than allowed.
+  // ##########################################################################
+  void Extender::permutationsExceeded(
+    const ComplexSelectorObj& complex,
+    size_t budget)
+  {
+    sass::ostream msg;
+    msg << "Extending \"" << complex->to_string() << "\" needs more than "
+      << budget << " selector permutations";
+    throw Exception::BudgetExceeded(msg.str());
+  }
+  // permutationsExceeded
+
 }
@@ -8,6 +8,7 @@
 #include "ast_helpers.hpp"
 #include "ast_fwd_decl.hpp"
 #include "operation.hpp"
+#include "interrupt.hpp"
 #include "extension.hpp"
 #include "backtrace.hpp"
 #include "ordered_map.hpp"
@@ -140,6 +141,11 @@ namespace Sass {
 
   public:
 
+    // ##########################################################################
+    // Polled for each complex selector that is extended, if set.
+    // ##########################################################################
+    Interrupt* interrupt;
+
     // Constructor without default [mode].
     // [traces] are needed to throw errors.
     Extender(Backtraces& traces);
@@ -392,6 +398,13 @@ namespace Sass {
     static bool hasExactlyOne(const ComplexSelectorObj& vec);
     static bool hasMoreThanOne(const ComplexSelectorObj& vec);
 
+    // ##########################################################################
+    // Throws when extending [complex] needs more permutations than allowed.
+    // ##########################################################################
+    static void permutationsExceeded(
+      const ComplexSelectorObj& complex,
+      size_t budget);
+
   };
 
 }
@@ -14,6 +14,7 @@
 # include <unistd.h>
 #endif
 #include <cstdio>
+#include <cstring>
 #include <vector>
 #include <algorithm>
 #include <sys/stat.h>
@@ -26,6 +27,7 @@
 #include "util.hpp"
 #include "util_string.hpp"
 #include "sass2scss.h"
+#include "MurmurHash2.hpp"
 
 #ifdef _WIN32
 # include <windows.h>
@@ -101,6 +103,63 @@ namespace Sass {
       #endif
     }
 
+    // test if path exists and is a directory
+    bool dir_exists(const sass::string& path)
+    {
+      #ifdef _WIN32
+        wchar_t resolved[32768];
+        // windows unicode filepaths are encoded in utf16
+        sass::string abspath(join_paths(get_cwd(), path));
+        if (!(abspath[0] == '/' && abspath[1] == '/')) {
+          abspath = "//?/" + abspath;
+        }
+        std::wstring wpath(UTF_8::convert_to_utf16(abspath));
+        std::replace(wpath.begin(), wpath.end(), '/', '\\');
+        DWORD rv = GetFullPathNameW(wpath.c_str(), 32767, resolved, NULL);
+        if (rv > 32767) throw Exception::OperationError("Path is too long");
+        if (rv == 0) throw Exception::OperationError("Path could not be resolved");
+        DWORD dwAttrib = GetFileAttributesW(resolved);
+        return (dwAttrib != INVALID_FILE_ATTRIBUTES &&
+               (dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
+      #else
+        struct stat st_buf;
+        return (stat (path.c_str(), &st_buf) == 0) &&
+               (S_ISDIR (st_buf.st_mode));
+      #endif
+    }
+
+    bool ResolverCache::file_exists(const sass::string& path)
+    {
+      auto it = files.find(path);
+      if (it != files.end()) { ++ hits_; return it->second; }
+      ++ probes_;
+      return files[path] = File::file_exists(path);
+    }
+
+    bool ResolverCache::dir_exists(const sass::string& path)
+    {
+      // empty means the current directory
+      if (path.empty()) return true;
+      auto it = dirs.find(path);
+      if (it != dirs.end()) { ++ hits_; return it->second; }
+      ++ probes_;
+      return dirs[path] = File::dir_exists(path);
+    }
+
+    sass::vector<sass::string> ResolverCache::missing_files() const
+    {
+      sass::vector<sass::string> paths;
+      for (auto& file : files) if (!file.second) paths.push_back(file.first);
+      return paths;
+    }
+
+    sass::vector<sass::string> ResolverCache::missing_dirs() const
+    {
+      sass::vector<sass::string> paths;
+      for (auto& dir : dirs) if (!dir.second) paths.push_back(dir.first);
+      return paths;
+    }
+
     // return if given path is absolute
     // works with *nix and windows paths
     bool is_absolute_path(const sass::string& path)
@@ -341,32 +400,37 @@ namespace Sass {
     // (4) given + extension
     // (5) given + _index.scss
     // (6) given + _index.sass
-    sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file, const sass::vector<sass::string>& exts)
+    static sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file, const sass::vector<sass::string>& exts, ResolverCache* cache)
     {
-      sass::string filename = join_paths(root, file);
       // split the filename
       sass::string base(dir_name(file));
       sass::string name(base_name(file));
       sass::vector<Include> includes;
+      // use the cache if we got one
+      auto exists = [cache](const sass::string& path) {
+        return cache ? cache->file_exists(path) : file_exists(path);
+      };
+      // no candidate can exist without its directory
+      if (cache && !cache->dir_exists(join_paths(root, base))) return includes;
       // create full path (maybe relative)
       sass::string rel_path(join_paths(base, name));
       sass::string abs_path(join_paths(root, rel_path));
-      if (file_exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
+      if (exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
       // next test variation with underscore
       rel_path = join_paths(base, "_" + name);
       abs_path = join_paths(root, rel_path);
-      if (file_exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
+      if (exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
       // next test exts plus underscore
       for(auto ext : exts) {
         rel_path = join_paths(base, "_" + name + ext);
         abs_path = join_paths(root, rel_path);
-        if (file_exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
+        if (exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
       }
       // next test plain name with exts
       for(auto ext : exts) {
         rel_path = join_paths(base, name + ext);
         abs_path = join_paths(root, rel_path);
-        if (file_exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
+        if (exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
       }
       // index files
       if (includes.size() == 0) {
@@ -374,23 +438,35 @@ namespace Sass {
         for(auto ext : exts) {
           if (ends_with(name, ext)) return includes;
         }
+        // index files need the directory to exist
+        if (cache && !cache->dir_exists(join_paths(root, join_paths(base, name)))) return includes;
         // next test underscore index exts
         for(auto ext : exts) {
           rel_path = join_paths(base, join_paths(name, "_index" + ext));
           abs_path = join_paths(root, rel_path);
-          if (file_exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
+          if (exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
         }
         // next test plain index exts
         for(auto ext : exts) {
           rel_path = join_paths(base, join_paths(name, "index" + ext));
           abs_path = join_paths(root, rel_path);
-          if (file_exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
+          if (exists(abs_path)) includes.push_back({{ rel_path, root }, abs_path });
         }
       }
       // nothing found
       return includes;
     }
 
+    sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file, const sass::vector<sass::string>& exts)
+    {
+      return resolve_includes(root, file, exts, nullptr);
+    }
+
+    sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file, ResolverCache& cache, const sass::vector<sass::string>& exts)
+    {
+      return resolve_includes(root, file, exts, &cache);
+    }
+
     sass::vector<sass::string> find_files(const sass::string& file, const sass::vector<sass::string> paths)
     {
       sass::vector<sass::string> includes;
@@ -507,6 +583,14 @@ namespace Sass {
       }
     }
 
+    // cheap 64-bit fingerprint of a loaded resource,
+    // missing resources are remembered as zero
+    uint64_t digest(const char* contents)
+    {
+      if (contents == nullptr) return 0;
+      return MurmurHash64A(contents, (int)std::strlen(contents), 0x7361737364696765ULL);
+    }
+
     // split a path string delimited by semicolons or colons (OS dependent)
     sass::vector<sass::string> split_path_list(const char* str)
     {
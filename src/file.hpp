@@ -7,6 +7,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 #include "sass/context.h"
 #include "ast_fwd_decl.hpp"
@@ -22,6 +23,9 @@ namespace Sass {
     // test if path exists and is a file
     bool file_exists(const sass::string& file);
 
+    // test if path exists and is a directory
+    bool dir_exists(const sass::string& path);
+
     // return if given path is absolute
     // works with *nix and windows paths
     bool is_absolute_path(const sass::string& path);
@@ -68,6 +72,9 @@ namespace Sass {
     // will auto convert .sass files
     char* read_file(const sass::string& file);
 
+    // fingerprint of loaded file contents
+    uint64_t digest(const char* contents);
+
   }
 
   // requested import
@@ -114,9 +121,36 @@ namespace Sass {
 
   namespace File {
 
+    // remembers file system probes made while resolving
+    // imports, including the negative ones, so each path
+    // is only checked once per compilation. A missing
+    // directory answers all candidates below it at once.
+    class ResolverCache {
+      private:
+        std::unordered_map<sass::string, bool> files;
+        std::unordered_map<sass::string, bool> dirs;
+        // number of probes answered from memory
+        size_t hits_;
+        // number of probes that hit the file system
+        size_t probes_;
+      public:
+        ResolverCache() : hits_(0), probes_(0) { }
+        bool file_exists(const sass::string& path);
+        bool dir_exists(const sass::string& path);
+        size_t hits() const { return hits_; }
+        size_t probes() const { return probes_; }
+        // candidates that were found to be missing
+        sass::vector<sass::string> missing_files() const;
+        sass::vector<sass::string> missing_dirs() const;
+    };
+
     sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file,
       const sass::vector<sass::string>& exts = { ".scss", ".sass", ".css" });
 
+    // same as above but answered via the given cache
+    sass::vector<Include> resolve_includes(const sass::string& root, const sass::string& file, ResolverCache& cache,
+      const sass::vector<sass::string>& exts = { ".scss", ".sass", ".css" });
+
   }
 
 }
@@ -18,7 +18,7 @@ namespace Sass {
     Signature keywords_sig = "keywords($args)";
     BUILT_IN(keywords)
     {
-      List_Obj arglist = SASS_MEMORY_COPY(ARG("$args", List)); // copy
+      List_Obj arglist = ARG("$args", List);
       Map_Obj result = SASS_MEMORY_NEW(Map, pstate, 1);
       for (size_t i = arglist->size(), L = arglist->length(); i < L; ++i) {
         ExpressionObj obj = arglist->at(i);
@@ -202,7 +202,8 @@ namespace Sass {
       if (m) {
         l = m->to_list(pstate);
       }
-      List* result = SASS_MEMORY_COPY(l);
+      // only copy if the list is referenced elsewhere
+      List_Obj result = SASS_MEMORY_COW(l.ptr());
       sass::string sep_str(unquote(sep->value()));
       if (sep_str != "auto") { // check default first
         if (sep_str == "space") result->separator(SASS_SPACE);
@@ -220,13 +221,15 @@ namespace Sass {
       } else {
         result->append(v);
       }
-      return result;
+      return result.detach();
     }
 
     Signature zip_sig = "zip($lists...)";
     BUILT_IN(zip)
     {
-      List_Obj arglist = SASS_MEMORY_COPY(ARG("$lists", List));
+      List_Obj arglist = ARG("$lists", List);
+      // collect the lists without mutating the shared arguments
+      sass::vector<List_Obj> lists;
       size_t shortest = 0;
       for (size_t i = 0, L = arglist->length(); i < L; ++i) {
         List_Obj ith = Cast<List>(arglist->value_at_index(i));
@@ -238,21 +241,16 @@ namespace Sass {
             ith = SASS_MEMORY_NEW(List, pstate, 1);
             ith->append(arglist->value_at_index(i));
           }
-          if (arglist->is_arglist()) {
-            Argument_Obj arg = (Argument*)(arglist->at(i).ptr()); // XXX
-            arg->value(ith);
-          } else {
-            (*arglist)[i] = ith;
-          }
         }
+        lists.push_back(ith);
         shortest = (i ? std::min(shortest, ith->length()) : ith->length());
       }
       List* zippers = SASS_MEMORY_NEW(List, pstate, shortest, SASS_COMMA);
-      size_t L = arglist->length();
+      size_t L = lists.size();
       for (size_t i = 0; i < shortest; ++i) {
         List* zipper = SASS_MEMORY_NEW(List, pstate, L);
         for (size_t j = 0; j < L; ++j) {
-          zipper->append(Cast<List>(arglist->value_at_index(j))->at(i));
+          zipper->append(lists[j]->at(i));
         }
         zippers->append(zipper);
       }
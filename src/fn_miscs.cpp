@@ -100,6 +100,7 @@ namespace Sass {
 
       if (ss) {
         function = Util::normalize_underscores(unquote(ss->value()));
+        count_warning();
         std::cerr << "DEPRECATION WARNING: ";
         std::cerr << "Passing a string to call() is deprecated and will be illegal" << std::endl;
         std::cerr << "in Sass 4.0. Use call(get-function(" + quote(function) + ")) instead." << std::endl;
@@ -108,7 +109,7 @@ namespace Sass {
         function = ff->name();
       }
 
-      List_Obj arglist = SASS_MEMORY_COPY(ARG("$args", List));
+      List_Obj arglist = ARG("$args", List);
 
       Arguments_Obj args = SASS_MEMORY_NEW(Arguments, pstate);
       // sass::string full_name(name + "[f]");
@@ -11,6 +11,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <thread>
+#include <mutex>
 
 #include "ast.hpp"
 #include "units.hpp"
@@ -71,6 +72,17 @@ namespace Sass {
     // generally only used to seed a PRNG such as mt19937.
     static std::mt19937 rand(static_cast<unsigned int>(GetSeed()));
 
+    // the generator is shared by all compilations, which
+    // may run on different threads, so draws are serialized
+    static std::mutex rand_mutex;
+
+    static double random_between(double lo, double hi)
+    {
+      std::uniform_real_distribution<> distributor(lo, hi);
+      std::lock_guard<std::mutex> lock(rand_mutex);
+      return distributor(rand);
+    }
+
     ///////////////////
     // NUMBER FUNCTIONS
     ///////////////////
@@ -166,6 +178,8 @@ namespace Sass {
     Signature random_sig = "random($limit:false)";
     BUILT_IN(random)
     {
+      // results must not be cached
+      ctx.deterministic = false;
       AST_Node_Obj arg = env["$limit"];
       Value* v = Cast<Value>(arg);
       Number* l = Cast<Number>(arg);
@@ -183,13 +197,11 @@ namespace Sass {
           err << "Expected $limit to be an integer but got " << lv << " for `random'";
           error(err.str(), pstate, traces);
         }
-        std::uniform_real_distribution<> distributor(1, lv + 1);
-        uint_fast32_t distributed = static_cast<uint_fast32_t>(distributor(rand));
+        uint_fast32_t distributed = static_cast<uint_fast32_t>(random_between(1, lv + 1));
         return SASS_MEMORY_NEW(Number, pstate, (double)distributed);
       }
       else if (b) {
-        std::uniform_real_distribution<> distributor(0, 1);
-        double distributed = static_cast<double>(distributor(rand));
+        double distributed = random_between(0, 1);
         return SASS_MEMORY_NEW(Number, pstate, distributed);
       } else if (v) {
         traces.push_back(Backtrace(pstate));
@@ -203,9 +215,9 @@ namespace Sass {
     Signature unique_id_sig = "unique-id()";
     BUILT_IN(unique_id)
     {
+      ctx.deterministic = false;
       sass::ostream ss;
-      std::uniform_real_distribution<> distributor(0, 4294967296); // 16^8
-      uint_fast32_t distributed = static_cast<uint_fast32_t>(distributor(rand));
+      uint_fast32_t distributed = static_cast<uint_fast32_t>(random_between(0, 4294967296)); // 16^8
       ss << "u" << std::setfill('0') << std::setw(8) << std::hex << distributed;
       return SASS_MEMORY_NEW(String_Quoted, pstate, ss.str());
     }
@@ -79,7 +79,7 @@ namespace Sass {
       size_t len = sass::string::npos;
       try {
         String_Constant* s = ARG("$string", String_Constant);
-        len = UTF_8::code_point_count(s->value(), 0, s->value().size());
+        len = s->code_points().count();
 
       }
       // handle any invalid utf8 errors
@@ -106,11 +106,12 @@ namespace Sass {
           strm << " is not an int";
           error(strm.str(), pstate, traces);
         }
-        size_t len = UTF_8::code_point_count(str, 0, str.size());
+        const UTF_8::CodePoints& code_points = s->code_points();
+        size_t len = code_points.count();
 
         if (index > 0 && index <= len) {
           // positive and within string length
-          str.insert(UTF_8::offset_at_position(str, static_cast<size_t>(index) - 1), ins);
+          str.insert(code_points.offset_at_position(str, static_cast<size_t>(index) - 1), ins);
         }
         else if (index > len) {
           // positive and past string length
@@ -122,7 +123,7 @@ namespace Sass {
         else if (std::abs(index) <= len) {
           // negative and within string length
           index += len + 1;
-          str.insert(UTF_8::offset_at_position(str, static_cast<size_t>(index)), ins);
+          str.insert(code_points.offset_at_position(str, static_cast<size_t>(index)), ins);
         }
         else {
           // negative and past string length
@@ -146,14 +147,14 @@ namespace Sass {
       try {
         String_Constant* s = ARG("$string", String_Constant);
         String_Constant* t = ARG("$substring", String_Constant);
-        sass::string str = s->value();
-        sass::string substr = t->value();
+        const sass::string& str = s->value();
+        const sass::string& substr = t->value();
 
         size_t c_index = str.find(substr);
         if(c_index == sass::string::npos) {
           return SASS_MEMORY_NEW(Null, pstate);
         }
-        index = UTF_8::code_point_count(str, 0, c_index) + 1;
+        index = s->code_points().position_at_offset(str, c_index) + 1;
       }
       // handle any invalid utf8 errors
       // other errors will be re-thrown
@@ -181,9 +182,10 @@ namespace Sass {
 
         String_Quoted* ss = Cast<String_Quoted>(s);
 
-        sass::string str(s->value());
+        const sass::string& str(s->value());
+        const UTF_8::CodePoints& code_points = s->code_points();
 
-        size_t size = utf8::distance(str.begin(), str.end());
+        size_t size = code_points.count();
 
         if (!Cast<Number>(env["$end-at"])) {
           end_at = -1;
@@ -215,11 +217,9 @@ namespace Sass {
 
         if (start_at <= end_at)
         {
-          sass::string::iterator start = str.begin();
-          utf8::advance(start, start_at - 1, str.end());
-          sass::string::iterator end = start;
-          utf8::advance(end, end_at - start_at + 1, str.end());
-          newstr = sass::string(start, end);
+          size_t start = code_points.offset_at_position(str, static_cast<size_t>(start_at) - 1);
+          size_t end = code_points.offset_at_position(str, static_cast<size_t>(end_at));
+          newstr = str.substr(start, end - start);
         }
         if (ss) {
           if(ss->quote_mark()) newstr = quote(newstr);
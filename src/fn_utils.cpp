@@ -54,7 +54,7 @@ namespace Sass {
       return str.substr(0, str.find('('));
     }
 
-    Map* get_arg_m(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    Map* get_arg_m(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, const Backtraces& traces)
     {
       AST_Node* value = env[argname];
       if (Map* map = Cast<Map>(value)) return map;
@@ -65,7 +65,7 @@ namespace Sass {
       return get_arg<Map>(argname, env, sig, pstate, traces);
     }
 
-    double get_arg_r(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, double lo, double hi)
+    double get_arg_r(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, const Backtraces& traces, double lo, double hi)
     {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       Number tmpnr(val);
@@ -80,7 +80,7 @@ namespace Sass {
       return v;
     }
 
-    Number* get_arg_n(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    Number* get_arg_n(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, const Backtraces& traces)
     {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       val = SASS_MEMORY_COPY(val);
@@ -88,7 +88,7 @@ namespace Sass {
       return val;
     }
 
-    double get_arg_val(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    double get_arg_val(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, const Backtraces& traces)
     {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       Number tmpnr(val);
@@ -96,7 +96,7 @@ namespace Sass {
       return tmpnr.value();
     }
 
-    double color_num(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces)
+    double color_num(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, const Backtraces& traces)
     {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       Number tmpnr(val);
@@ -108,7 +108,7 @@ namespace Sass {
       }
     }
 
-    double alpha_num(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces) {
+    double alpha_num(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, const Backtraces& traces) {
       Number* val = get_arg<Number>(argname, env, sig, pstate, traces);
       Number tmpnr(val);
       tmpnr.reduce();
@@ -119,7 +119,7 @@ namespace Sass {
       }
     }
 
-    SelectorListObj get_arg_sels(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx) {
+    SelectorListObj get_arg_sels(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, const Backtraces& traces, Context& ctx) {
       ExpressionObj exp = ARG(argname, Expression);
       if (exp->concrete_type() == Expression::NULL_VAL) {
         sass::ostream msg;
@@ -135,7 +135,7 @@ namespace Sass {
       return Parser::parse_selector(source, ctx, traces, false);
     }
 
-    CompoundSelectorObj get_arg_sel(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, Backtraces traces, Context& ctx) {
+    CompoundSelectorObj get_arg_sel(const sass::string& argname, Env& env, Signature sig, SourceSpan pstate, const Backtraces& traces, Context& ctx) {
       ExpressionObj exp = ARG(argname, Expression);
       if (exp->concrete_type() == Expression::NULL_VAL) {
         sass::ostream msg;
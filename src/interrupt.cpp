@@ -0,0 +1,80 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <chrono>
+#include "interrupt.hpp"
+#include "error_handling.hpp"
+#include "memory/shared_ptr.hpp"
+
+namespace Sass {
+
+  static int64_t now()
+  {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+  }
+
+  Interrupt::Interrupt(size_t max_memory, size_t max_output_size, size_t max_permutations)
+  : cancelled(false), deadline(0), polls(0),
+    max_memory(max_memory),
+    max_output_size(max_output_size),
+    max_permutations(max_permutations),
+    memory_thread(std::this_thread::get_id()),
+    memory_start(SharedObj::getAllocatedBytes())
+  { }
+
+  void Interrupt::start_counting()
+  {
+    memory_thread = std::this_thread::get_id();
+    memory_start = SharedObj::getAllocatedBytes();
+  }
+
+  void Interrupt::cancel()
+  {
+    cancelled.store(true, std::memory_order_relaxed);
+  }
+
+  // counted from now, zero removes the deadline
+  void Interrupt::set_deadline(size_t milliseconds)
+  {
+    if (milliseconds == 0) {
+      deadline.store(0, std::memory_order_relaxed);
+      return;
+    }
+    std::chrono::steady_clock::duration timeout =
+      std::chrono::milliseconds(milliseconds);
+    deadline.store(now() + timeout.count(), std::memory_order_relaxed);
+  }
+
+  void Interrupt::check_limits()
+  {
+    int64_t until = deadline.load(std::memory_order_relaxed);
+    if (until && now() >= until) {
+      throw Exception::Interrupted("Compilation exceeded its deadline");
+    }
+    // objects of other threads are not counted here
+    if (max_memory && memory_thread == std::this_thread::get_id()) {
+      int64_t used = SharedObj::getAllocatedBytes() - memory_start;
+      if (used > 0 && size_t(used) > max_memory) {
+        sass::ostream msg;
+        msg << "Compilation used " << used << " bytes, "
+          << "more than its memory budget of " << max_memory << " bytes";
+        throw Exception::BudgetExceeded(msg.str());
+      }
+    }
+  }
+
+  void Interrupt::output_exceeded(size_t size)
+  {
+    sass::ostream msg;
+    msg << "Compilation wrote " << size << " bytes, "
+      << "more than its output budget of " << max_output_size << " bytes";
+    throw Exception::BudgetExceeded(msg.str());
+  }
+
+  void Interrupt::stop()
+  {
+    throw Exception::Interrupted("Compilation cancelled");
+  }
+
+}
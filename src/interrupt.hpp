@@ -0,0 +1,63 @@
+#ifndef SASS_INTERRUPT_H
+#define SASS_INTERRUPT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace Sass {
+
+  // Lets another thread stop a running compile. Passes poll
+  // it at points that may repeat without bound, it throws
+  // Exception::Interrupted once the compile should stop.
+  // It also holds the budgets of the compile and throws
+  // Exception::BudgetExceeded once one is used up.
+  class Interrupt {
+
+    std::atomic<bool> cancelled;
+    // steady clock ticks, zero if there is none
+    std::atomic<int64_t> deadline;
+    // the clock is only read every few polls
+    size_t polls;
+
+    // budgets from the options, zero if there is none
+    size_t max_memory;
+    size_t max_output_size;
+    size_t max_permutations;
+    // memory is counted per thread, from where we started
+    std::thread::id memory_thread;
+    int64_t memory_start;
+
+    void check_limits();
+    void stop();
+    void output_exceeded(size_t size);
+
+  public:
+    Interrupt(size_t max_memory = 0, size_t max_output_size = 0, size_t max_permutations = 0);
+
+    // count memory from here on this thread
+    void start_counting();
+
+    // may be called from any thread
+    void cancel();
+    void set_deadline(size_t milliseconds);
+
+    void poll()
+    {
+      if (cancelled.load(std::memory_order_relaxed)) stop();
+      if (++polls % 16 == 0) check_limits();
+    }
+
+    void check_output(size_t size)
+    {
+      if (max_output_size && size > max_output_size) output_exceeded(size);
+    }
+
+    size_t permutation_budget() const { return max_permutations; }
+
+  };
+
+}
+
+#endif
@@ -11,6 +11,35 @@
 
 namespace Sass {
 
+  // bytes of the shared objects alive on this thread
+  static thread_local int64_t allocatedBytes = 0;
+
+  void* SharedObj::operator new(size_t nbytes)
+  {
+    #ifdef SASS_CUSTOM_ALLOCATOR
+    void* ptr = allocateMem(nbytes);
+    #else
+    void* ptr = ::operator new(nbytes);
+    #endif
+    allocatedBytes += nbytes;
+    return ptr;
+  }
+
+  void SharedObj::operator delete(void* ptr, size_t nbytes)
+  {
+    allocatedBytes -= nbytes;
+    #ifdef SASS_CUSTOM_ALLOCATOR
+    deallocateMem(ptr);
+    #else
+    ::operator delete(ptr);
+    #endif
+  }
+
+  int64_t SharedObj::getAllocatedBytes()
+  {
+    return allocatedBytes;
+  }
+
   #ifdef DEBUG_SHARED_PTR
   void SharedObj::dumpMemLeaks() {
     if (!all.empty()) {
@@ -6,6 +6,7 @@
 #include "../sass.hpp"
 #include "allocator.hpp"
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <type_traits>
@@ -21,8 +22,9 @@ namespace Sass {
   class SharedPtr;
 
   ///////////////////////////////////////////////////////////////////////////////
-  // Use macros for the allocation task, since overloading operator `new`
-  // has been proven to be flaky under certain compilers (see comment below).
+  // Use macros for the allocation task, so debug builds can trace where
+  // each object was created. SharedObj overloads operator `new` only to
+  // count the allocated bytes (see below), the macros still wrap it.
   ///////////////////////////////////////////////////////////////////////////////
 
   #ifdef DEBUG_SHARED_PTR
@@ -36,6 +38,9 @@ namespace Sass {
     #define SASS_MEMORY_CLONE(obj) \
       ((obj)->clone(__FILE__, __LINE__)) \
 
+    #define SASS_MEMORY_COW(obj) \
+      ((obj)->isShared() ? (obj)->copy(__FILE__, __LINE__) : (obj)) \
+
   #else
 
     #define SASS_MEMORY_NEW(Class, ...) \
@@ -47,6 +52,9 @@ namespace Sass {
     #define SASS_MEMORY_CLONE(obj) \
       ((obj)->clone()) \
 
+    #define SASS_MEMORY_COW(obj) \
+      ((obj)->isShared() ? (obj)->copy() : (obj)) \
+
   #endif
 
   // SharedObj is the base class for all objects that can be stored as a shared object
@@ -92,14 +100,18 @@ namespace Sass {
 
     static void setTaint(bool val) { taint = val; }
 
-    #ifdef SASS_CUSTOM_ALLOCATOR
-    inline void* operator new(size_t nbytes) {
-      return allocateMem(nbytes);
-    }
-    inline void operator delete(void* ptr) {
-      return deallocateMem(ptr);
-    }
-    #endif
+    // Values are treated as immutable once they are referenced
+    // from more than one place (e.g. the AST and an environment).
+    // Use `SASS_MEMORY_COW` to get an object that is safe to mutate.
+    bool isShared() const { return refcount > 1; }
+
+    // Counts the bytes of the objects alive on this thread, so a
+    // compilation can check it against its budget. The counter is
+    // thread local, objects freed on another thread are subtracted
+    // there, which is fine since every compile owns its objects.
+    void* operator new(size_t nbytes);
+    void operator delete(void* ptr, size_t nbytes);
+    static int64_t getAllocatedBytes();
 
     virtual sass::string to_string() const = 0;
    protected:
@@ -0,0 +1,217 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+#include "ast.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+#include "optimize_rules.hpp"
+#include "util.hpp"
+
+namespace Sass {
+
+    // pseudo selectors every browser in use knows, from css2 and selectors level 3
+    static const std::unordered_set<sass::string> known_pseudo_classes {
+      "link", "visited", "hover", "active", "focus", "target", "lang",
+      "enabled", "disabled", "checked", "root", "empty",
+      "first-child", "last-child", "only-child", "nth-child", "nth-last-child",
+      "first-of-type", "last-of-type", "only-of-type", "nth-of-type", "nth-last-of-type",
+      "not"
+    };
+    static const std::unordered_set<sass::string> known_pseudo_elements {
+      "before", "after", "first-line", "first-letter"
+    };
+
+    static bool safe_to_group(const SelectorList* list);
+
+    static bool safe_to_group(const PseudoSelector* pseudo)
+    {
+      // vendor prefixed names are only known to some browsers
+      if (pseudo->normalized() != pseudo->name()) return false;
+      if (pseudo->isElement()) {
+        return known_pseudo_elements.count(pseudo->name()) != 0;
+      }
+      if (known_pseudo_classes.count(pseudo->name()) == 0) return false;
+      const SelectorList* selector = pseudo->selector();
+      if (selector == nullptr) return true;
+      // newer forms like `:not(.a .b)` or `:nth-child(2n of .a)`
+      if (pseudo->name() != "not" || selector->length() != 1) return false;
+      const ComplexSelector* complex = selector->get(0);
+      if (complex->length() != 1) return false;
+      const CompoundSelector* compound = complex->get(0)->getCompound();
+      return compound && compound->length() == 1 && safe_to_group(selector);
+    }
+
+    // browsers drop a whole selector list if they do not know one of
+    // its selectors, so only group selectors that are known everywhere
+    static bool safe_to_group(const SelectorList* list)
+    {
+      for (const ComplexSelectorObj& complex : list->elements()) {
+        for (const SelectorComponentObj& component : complex->elements()) {
+          CompoundSelector* compound = component->getCompound();
+          if (compound == nullptr) continue;
+          for (const SimpleSelectorObj& simple : compound->elements()) {
+            if (PseudoSelector* pseudo = simple->getPseudoSelector()) {
+              if (!safe_to_group(pseudo)) return false;
+            }
+            // case flags like `[a=b i]` are from selectors level 4
+            else if (AttributeSelector* attribute = Cast<AttributeSelector>(simple)) {
+              if (attribute->modifier() != 0) return false;
+            }
+          }
+        }
+      }
+      return true;
+    }
+
+    Optimize_Rules::Optimize_Rules(Sass_Inspect_Options opt, bool merge_rules, bool remove_duplicates)
+    : opt(opt), merge_rules(merge_rules), remove_duplicates(remove_duplicates)
+    { }
+
+    // only touch rules holding nothing but declarations and comments
+    bool Optimize_Rules::is_mergeable(StyleRule* r)
+    {
+      if (!r->selector() || !r->block()) return false;
+      for (const Statement_Obj& stm : r->block()->elements()) {
+        if (Declaration* d = Cast<Declaration>(stm)) {
+          if (!Util::isPrintable(d, opt.output_style)) return false;
+        }
+        else if (!Cast<Comment>(stm)) return false;
+      }
+      return true;
+    }
+
+    sass::string Optimize_Rules::declaration_key(Declaration* d)
+    {
+      sass::string key(d->property()->to_string(opt));
+      key += ':';
+      key += d->value()->to_string(opt);
+      if (d->is_important()) key += "!important";
+      return key;
+    }
+
+    bool Optimize_Rules::has_equal_body(StyleRule* lhs, StyleRule* rhs)
+    {
+      Block* lb = lhs->block();
+      Block* rb = rhs->block();
+      if (lb->length() != rb->length()) return false;
+      for (size_t i = 0, L = lb->length(); i < L; ++i) {
+        Declaration* ld = Cast<Declaration>(lb->get(i));
+        Declaration* rd = Cast<Declaration>(rb->get(i));
+        if (!ld || !rd) return false;
+        if (declaration_key(ld) != declaration_key(rd)) return false;
+      }
+      return true;
+    }
+
+    // an earlier copy of a declaration never decides anything
+    void Optimize_Rules::remove_duplicate_declarations(Block* b)
+    {
+      sass::vector<Statement_Obj>& children = b->elements();
+      std::unordered_set<sass::string> seen;
+      bool removed = false;
+      for (size_t i = children.size(); i-- > 0;) {
+        Declaration* d = Cast<Declaration>(children[i]);
+        if (d && !seen.insert(declaration_key(d)).second) {
+          children[i] = {};
+          removed = true;
+        }
+      }
+      if (removed) {
+        children.erase(std::remove(children.begin(), children.end(), Statement_Obj()), children.end());
+      }
+    }
+
+    void Optimize_Rules::operator()(Block* b)
+    {
+      if (merge_rules) {
+        sass::vector<Statement_Obj>& children = b->elements();
+        // the last rule kept and where it is now
+        StyleRuleObj previous;
+        size_t previous_at = 0;
+        // previous after it was copied to merge into it
+        StyleRuleObj merged;
+        // selectors of merged once the first other one was added
+        SelectorListObj grouped;
+        std::unordered_set<ComplexSelectorObj, ObjHash, ObjEquality> grouped_set;
+        bool previous_safe = false;
+        size_t n = 0;
+        for (size_t i = 0, L = children.size(); i < L; ++i) {
+          StyleRule* rule = Cast<StyleRule>(children[i]);
+          // rules that print nothing do not separate others
+          if (rule && !Util::isPrintable(rule, opt.output_style)) {
+            children[n++] = children[i];
+            continue;
+          }
+          if (!rule || !is_mergeable(rule)) {
+            previous = {};
+            children[n++] = children[i];
+            continue;
+          }
+          bool rule_safe = safe_to_group(rule->selector());
+          if (previous) {
+            bool same_selector = *previous->selector() == *rule->selector();
+            if (same_selector || (previous_safe && rule_safe && has_equal_body(previous, rule)))
+            {
+              // copy once per run, selectors and blocks may be shared
+              if (merged != previous) {
+                merged = SASS_MEMORY_COPY(previous);
+                merged->block(SASS_MEMORY_COPY(previous->block()));
+                children[previous_at] = merged;
+                previous = merged;
+                grouped = {};
+              }
+              if (same_selector) {
+                merged->block()->concat(rule->block());
+              }
+              else {
+                // copy once per run and append in place afterwards
+                if (!grouped) {
+                  grouped = SASS_MEMORY_COPY(merged->selector());
+                  grouped_set.clear();
+                  grouped_set.insert(grouped->begin(), grouped->end());
+                  merged->selector(grouped);
+                }
+                for (const ComplexSelectorObj& complex : rule->selector()->elements()) {
+                  if (grouped_set.insert(complex).second) grouped->append(complex);
+                }
+              }
+              merged->group_end(rule->group_end());
+              continue;
+            }
+          }
+          previous = rule;
+          previous_safe = rule_safe;
+          previous_at = n;
+          children[n++] = children[i];
+        }
+        children.resize(n);
+      }
+      for (size_t i = 0, L = b->length(); i < L; ++i) {
+        if (b->get(i)) b->get(i)->perform(this);
+      }
+    }
+
+    void Optimize_Rules::operator()(StyleRule* r)
+    {
+      if (remove_duplicates && is_mergeable(r)) {
+        remove_duplicate_declarations(r->block());
+      }
+    }
+
+    void Optimize_Rules::operator()(CssMediaRule* rule)
+    {
+      if (rule->block()) operator()(rule->block());
+    }
+
+    void Optimize_Rules::operator()(SupportsRule* m)
+    {
+      if (m->block()) operator()(m->block());
+    }
+
+    void Optimize_Rules::operator()(AtRule* a)
+    {
+      if (a->block()) a->block()->perform(this);
+    }
+
+}
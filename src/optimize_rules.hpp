@@ -0,0 +1,43 @@
+#ifndef SASS_OPTIMIZE_RULES_H
+#define SASS_OPTIMIZE_RULES_H
+
+#include "ast_fwd_decl.hpp"
+#include "operation.hpp"
+
+namespace Sass {
+
+  // Shrinks the output after cssize without changing
+  // what it means. Only rules that follow each other
+  // are merged, since the cascade depends on order.
+  class Optimize_Rules : public Operation_CRTP<void, Optimize_Rules> {
+
+    Sass_Inspect_Options opt;
+    // merge rules with equal selectors or bodies
+    bool merge_rules;
+    // drop declarations repeated later in a rule
+    bool remove_duplicates;
+
+    bool is_mergeable(StyleRule*);
+    bool has_equal_body(StyleRule*, StyleRule*);
+    sass::string declaration_key(Declaration*);
+    void remove_duplicate_declarations(Block*);
+
+  public:
+    Optimize_Rules(Sass_Inspect_Options opt, bool merge_rules, bool remove_duplicates);
+    ~Optimize_Rules() { }
+
+    void operator()(Block*);
+    void operator()(StyleRule*);
+    void operator()(CssMediaRule*);
+    void operator()(SupportsRule*);
+    void operator()(AtRule*);
+
+    // ignore missed types
+    template <typename U>
+    void fallback(U x) {}
+
+  };
+
+}
+
+#endif
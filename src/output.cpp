@@ -46,7 +46,7 @@ namespace Sass {
     throw Exception::InvalidValue({}, *m);
   }
 
-  OutputBuffer Output::get_buffer(void)
+  const OutputBuffer& Output::get_buffer(void)
   {
 
     Emitter emitter(opt);
@@ -113,6 +113,10 @@ namespace Sass {
 
   void Output::operator()(StyleRule* r)
   {
+    if (interrupt) {
+      interrupt->poll();
+      interrupt->check_output(wbuf.buffer.size());
+    }
     Block_Obj b = r->block();
     SelectorListObj s = r->selector();
 
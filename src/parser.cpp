@@ -37,7 +37,9 @@ namespace Sass {
     traces(traces),
     indentation(0),
     nestings(0),
-    allow_parent(allow_parent)
+    allow_parent(allow_parent),
+    skipped_from(nullptr),
+    skipped_to(nullptr)
   {
     Block_Obj root = SASS_MEMORY_NEW(Block, pstate);
     stack.push_back(Scope::Root);
@@ -1445,9 +1447,11 @@ namespace Sass {
   Value* Parser::color_or_string(const sass::string& lexed) const
   {
     if (auto color = name_to_color(lexed)) {
-      auto c = SASS_MEMORY_NEW(Color_RGBA, color);
+      // do not copy the shared color table entry, its
+      // source span is shared by all parsing threads
+      auto c = SASS_MEMORY_NEW(Color_RGBA, pstate,
+        color->r(), color->g(), color->b(), color->a());
       c->is_delayed(true);
-      c->pstate(pstate);
       c->disp(lexed);
       return c;
     } else {
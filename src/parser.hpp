@@ -55,6 +55,10 @@ namespace Sass {
     size_t nestings;
     bool allow_parent;
     Token lexed;
+    // last white-space skip done by sneak, since
+    // most alternatives are tried from one position
+    const char* skipped_from;
+    const char* skipped_to;
 
     Parser(SourceData* source, Context& ctx, Backtraces, bool allow_parent = true);
 
@@ -102,9 +106,13 @@ namespace Sass {
       }
 
       // skip over spaces, tabs and sass line comments
-      const char* pos = optional_css_whitespace(it_position);
-      // always return a valid position
-      return pos ? pos : it_position;
+      if (it_position != skipped_from) {
+        const char* pos = optional_css_whitespace(it_position);
+        // always return a valid position
+        skipped_to = pos ? pos : it_position;
+        skipped_from = it_position;
+      }
+      return skipped_to;
 
     }
 
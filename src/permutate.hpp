@@ -159,6 +159,23 @@ namespace Sass {
   }
   // EO permutateAlt
 
+  // Returns how many paths `permutate` returns for the
+  // given lists, or `max + 1` if there are more of them.
+  template <class T>
+  size_t countPermutations(
+    const sass::vector<sass::vector<T>>& in, size_t max)
+  {
+    if (in.empty()) return 0;
+    size_t count = 1;
+    for (const sass::vector<T>& item : in) {
+      if (item.empty()) return 0;
+      if (count > max / item.size()) return max + 1;
+      count *= item.size();
+    }
+    return count;
+  }
+  // EO countPermutations
+
 }
 
 #endif
@@ -26,7 +26,7 @@ namespace Sass {
   }
 
   Offset::Offset(const size_t line, const size_t column)
-  : line(line), column(column) { }
+  : line(static_cast<uint32_t>(line)), column(static_cast<uint32_t>(column)) { }
 
   // init/create instance from const char substring
   Offset Offset::init(const char* beg, const char* end)
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <cstring>
+#include <cstdint>
 #include "source_data.hpp"
 #include "ast_fwd_decl.hpp"
 
@@ -38,8 +39,10 @@ namespace Sass {
       Offset off() { return *this; }
 
     public:
-      size_t line;
-      size_t column;
+      // 32 bits keep every span (and thus
+      // every ast node) small and cheap to copy
+      uint32_t line;
+      uint32_t column;
 
   };
 
@@ -0,0 +1,235 @@
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "result_cache.hpp"
+#include "context.hpp"
+#include "dep_graph.hpp"
+#include "error_handling.hpp"
+#include "file.hpp"
+#include "sass_context.hpp"
+#include "sass_functions.hpp"
+#include "util.hpp"
+#include "MurmurHash2.hpp"
+
+namespace Sass {
+
+  static sass::string to_hex(uint64_t value)
+  {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long) value);
+    return buffer;
+  }
+
+  static bool is_string(JsonNode* node)
+  {
+    return node && node->tag == JSON_STRING;
+  }
+
+  static bool is_array(JsonNode* node)
+  {
+    return node && node->tag == JSON_ARRAY;
+  }
+
+  static JsonNode* json_mkpaths(const sass::vector<sass::string>& paths)
+  {
+    JsonNode* array = json_mkarray();
+    for (const sass::string& path : paths) {
+      json_append_element(array, json_mkstring(path.c_str()));
+    }
+    return array;
+  }
+
+  // write to a private file first and move it into
+  // place, so readers never see a partial result
+  static void write_file(const sass::string& path, const char* data)
+  {
+    sass::ostream tmp;
+    tmp << path << "." << std::hash<std::thread::id>()(std::this_thread::get_id())
+        << "-" << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    sass::string tmp_path(tmp.str());
+    FILE* fp = std::fopen(tmp_path.c_str(), "wb");
+    if (fp == nullptr) return;
+    size_t len = std::strlen(data);
+    bool written = std::fwrite(data, 1, len, fp) == len;
+    if (std::fclose(fp) != 0) written = false;
+    if (written && std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      // windows does not replace existing files
+      std::remove(path.c_str());
+      written = std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    }
+    if (!written) std::remove(tmp_path.c_str());
+  }
+
+  ResultCache::ResultCache(Context& ctx, struct Sass_Context& c_ctx)
+  : ctx(ctx), c_ctx(c_ctx), path(), warnings(warnings_written())
+  {
+    if (c_ctx.cache_path == 0 || *c_ctx.cache_path == 0) return;
+    // custom callbacks must promise to be deterministic
+    for (auto fn : ctx.c_functions) if (!fn->deterministic) return;
+    for (auto imp : ctx.c_importers) if (!imp->deterministic) return;
+    for (auto imp : ctx.c_headers) if (!imp->deterministic) return;
+    path = File::join_paths(c_ctx.cache_path, fingerprint() + ".json");
+  }
+
+  // everything that may change the result, besides the loaded files
+  sass::string ResultCache::fingerprint() const
+  {
+    sass::ostream key;
+    auto add = [&key](const sass::string& value) {
+      key << value.size() << ":" << value;
+    };
+    add(libsass_version());
+    add(ctx.CWD);
+    add(ctx.input_path);
+    add(ctx.output_path);
+    add(ctx.source_map_file);
+    add(ctx.source_map_root);
+    add(ctx.indent);
+    add(ctx.linefeed);
+    key << c_ctx.type << ":" << c_ctx.precision << ":" << c_ctx.output_style << ":"
+        << c_ctx.source_comments << c_ctx.source_map_embed << c_ctx.source_map_contents
+        << c_ctx.source_map_file_urls << c_ctx.omit_source_map_url << c_ctx.is_indented_syntax_src
+        << c_ctx.merge_media_queries << c_ctx.merge_rules << c_ctx.remove_duplicate_declarations << ":"
+        << c_ctx.max_memory << ":" << c_ctx.max_output_size << ":" << c_ctx.max_selector_permutations;
+    for (const sass::string& inc : ctx.include_paths) add(inc);
+    for (const sass::string& plug : ctx.plugin_paths) add(plug);
+    for (auto fn : ctx.c_functions) add(fn->signature);
+    for (auto imp : ctx.c_importers) key << "i" << imp->priority;
+    for (auto imp : ctx.c_headers) key << "h" << imp->priority;
+    if (c_ctx.type == SASS_CONTEXT_DATA) {
+      auto& data_ctx = static_cast<struct Sass_Data_Context&>(c_ctx);
+      add(safe_str(data_ctx.source_string));
+      add(safe_str(data_ctx.srcmap_string));
+    }
+    sass::string str(key.str());
+    const char* data = str.c_str(); int len = (int)str.size();
+    return to_hex((uint64_t(MurmurHash2(data, len, 0x73617373)) << 32)
+      | MurmurHash2(data, len, 0x63616368));
+  }
+
+  bool ResultCache::load()
+  {
+    if (path.empty() || c_ctx.error_status) return false;
+    try {
+      char* contents = File::read_file(path);
+      if (contents == nullptr) return false;
+      JsonNode* json = json_decode(contents);
+      free(contents);
+      if (json == nullptr) return false;
+      bool hit = restore(json);
+      json_delete(json);
+      return hit;
+    }
+    catch (...) { return false; }
+  }
+
+  bool ResultCache::restore(JsonNode* json)
+  {
+    JsonNode* files = json_find_member(json, "files");
+    JsonNode* missing_files = json_find_member(json, "missing_files");
+    JsonNode* missing_dirs = json_find_member(json, "missing_dirs");
+    JsonNode* included = json_find_member(json, "included");
+    JsonNode* css = json_find_member(json, "css");
+    JsonNode* map = json_find_member(json, "map");
+    if (!is_array(files) || !is_array(missing_files) || !is_array(missing_dirs)) return false;
+    if (!is_array(included) || !is_string(css)) return false;
+    // the data entry is covered by the fingerprint
+    bool entry = c_ctx.type == SASS_CONTEXT_DATA;
+    std::unordered_map<sass::string, uint64_t> deps;
+    std::unordered_set<sass::string> dirs;
+    sass::string entry_path;
+    JsonNode* node;
+    json_foreach(node, files) {
+      JsonNode* file = json_find_member(node, "path");
+      JsonNode* digest = json_find_member(node, "digest");
+      if (!is_string(file) || !is_string(digest)) return false;
+      uint64_t expected = std::strtoull(digest->string_, nullptr, 16);
+      if (entry_path.empty()) entry_path = file->string_;
+      deps[file->string_] = expected;
+      if (entry) { entry = false; continue; }
+      char* contents = File::read_file(file->string_);
+      uint64_t actual = File::digest(contents);
+      free(contents);
+      if (contents == nullptr || actual != expected) return false;
+    }
+    // a new file could now win the import resolution
+    json_foreach(node, missing_files) {
+      if (!is_string(node) || File::file_exists(node->string_)) return false;
+      deps.emplace(File::rel2abs(node->string_), File::digest(nullptr));
+    }
+    json_foreach(node, missing_dirs) {
+      if (!is_string(node) || File::dir_exists(node->string_)) return false;
+      dirs.insert(File::rel2abs(node->string_));
+    }
+    sass::vector<sass::string> includes;
+    json_foreach(node, included) {
+      if (!is_string(node)) return false;
+      includes.push_back(node->string_);
+    }
+    if (copy_strings(includes, &c_ctx.included_files) == NULL)
+      throw(std::bad_alloc());
+    c_ctx.output_string = sass_copy_c_string(css->string_);
+    if (is_string(map)) c_ctx.source_map_string = sass_copy_c_string(map->string_);
+    // keep the dependency graph up to date
+    if (c_ctx.dependency_graph && !entry_path.empty() && c_ctx.type == SASS_CONTEXT_FILE) {
+      c_ctx.dependency_graph->record(entry_path, std::move(deps), std::move(dirs), true);
+    }
+    return true;
+  }
+
+  void ResultCache::store()
+  {
+    if (path.empty() || !ctx.deterministic) return;
+    // a cached result would not print the warnings again
+    if (warnings_written() != warnings) return;
+    if (c_ctx.error_status || c_ctx.output_string == 0) return;
+    try {
+      JsonNode* files = json_mkarray();
+      // included files and resources are pushed together
+      for (size_t i = 0; i < ctx.included_files.size(); ++i) {
+        JsonNode* file = json_mkobject();
+        sass::string abs_path(File::rel2abs(ctx.included_files[i], ".", ctx.CWD));
+        json_append_member(file, "path", json_mkstring(abs_path.c_str()));
+        uint64_t digest = File::digest(ctx.resources[i].contents);
+        json_append_member(file, "digest", json_mkstring(to_hex(digest).c_str()));
+        json_append_element(files, file);
+      }
+      sass::vector<sass::string> missing(ctx.resolver_cache.missing_files());
+      // the entry may also be found via the include paths
+      if (c_ctx.type == SASS_CONTEXT_FILE) {
+        sass::string candidate(File::rel2abs(ctx.input_path, ctx.CWD));
+        for (size_t i = 0; candidate != ctx.entry_path && i < ctx.include_paths.size(); ++i) {
+          missing.push_back(candidate);
+          candidate = File::rel2abs(ctx.input_path, ctx.include_paths[i]);
+        }
+      }
+      sass::vector<sass::string> includes;
+      for (char** inc = c_ctx.included_files; inc && *inc; ++inc) {
+        includes.push_back(*inc);
+      }
+      JsonNode* json = json_mkobject();
+      json_append_member(json, "files", files);
+      json_append_member(json, "missing_files", json_mkpaths(missing));
+      json_append_member(json, "missing_dirs", json_mkpaths(ctx.resolver_cache.missing_dirs()));
+      json_append_member(json, "included", json_mkpaths(includes));
+      json_append_member(json, "css", json_mkstring(c_ctx.output_string));
+      if (c_ctx.source_map_string) {
+        json_append_member(json, "map", json_mkstring(c_ctx.source_map_string));
+      }
+      char* data = json_encode(json);
+      json_delete(json);
+      if (data == nullptr) return;
+      write_file(path, data);
+      free(data);
+    }
+    // the cache is best effort
+    catch (...) { }
+  }
+
+}
@@ -0,0 +1,42 @@
+#ifndef SASS_RESULT_CACHE_H
+#define SASS_RESULT_CACHE_H
+
+// sass.hpp must go before all system headers to get the
+// __EXTENSIONS__ fix on Solaris.
+#include "sass.hpp"
+
+#include "sass/context.h"
+#include "json.hpp"
+
+namespace Sass {
+
+  class Context;
+
+  // Opt-in cache for whole compilation results. Each result is
+  // stored as one json file below the `cache_path` option, named
+  // after a fingerprint of the options, the entry and the custom
+  // functions. A stored result is only used while every file it
+  // loaded is unchanged and every import candidate that was not
+  // found is still missing. Compilations that print warnings are
+  // not stored, since a cached result could not print them again.
+  class ResultCache {
+    private:
+      Context& ctx;
+      struct Sass_Context& c_ctx;
+      // empty if this compilation can not be cached
+      sass::string path;
+      // warnings written before the compilation started
+      size_t warnings;
+      sass::string fingerprint() const;
+      bool restore(JsonNode* json);
+    public:
+      ResultCache(Context& ctx, struct Sass_Context& c_ctx);
+      // serve the compilation from the cache
+      bool load();
+      // remember the result of a finished compilation
+      void store();
+  };
+
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include "ast.hpp"
 
 #include "sass_functions.hpp"
+#include "dep_graph.hpp"
+#include "result_cache.hpp"
 #include "json.hpp"
 
 #define LFEED "\n"
@@ -18,11 +20,11 @@ namespace Sass {
     return json_mkstring(str.c_str());
   }
 
-  static void handle_string_error(Sass_Context* c_ctx, const sass::string& msg, int severety)
+  static void handle_string_error(Sass_Context* c_ctx, const sass::string& msg, int severety, const char* prefix = "Internal Error")
   {
     sass::ostream msg_stream;
     JsonNode* json_err = json_mkobject();
-    msg_stream << "Internal Error: " << msg << std::endl;
+    msg_stream << prefix << ": " << msg << std::endl;
     json_append_member(json_err, "status", json_mknumber(severety));
     json_append_member(json_err, "message", json_mkstring(msg.c_str()));
     json_append_member(json_err, "formatted", json_mkstream(msg_stream));
@@ -75,8 +77,9 @@ namespace Sass {
       }
 
       // now create the code trace (ToDo: maybe have util functions?)
-      if (e.pstate.position.line != sass::string::npos &&
-          e.pstate.position.column != sass::string::npos &&
+      // importers may report errors without a line or column
+      if (e.pstate.position.line != UINT32_MAX &&
+          e.pstate.position.column != UINT32_MAX &&
           e.pstate.getRawData() != nullptr &&
           e.pstate.source != nullptr) {
         Offset offset(e.pstate.position);
@@ -134,6 +137,12 @@ namespace Sass {
       msg_stream << "Unable to allocate memory: " << ba.what();
       handle_string_error(c_ctx, msg_stream.str(), 2);
     }
+    catch (Exception::Interrupted& e) {
+      handle_string_error(c_ctx, e.what(), 6, "Error");
+    }
+    catch (Exception::BudgetExceeded& e) {
+      handle_string_error(c_ctx, e.what(), 7, "Error");
+    }
     catch (std::exception& e) {
       handle_string_error(c_ctx, e.what(), 3);
     }
@@ -178,6 +187,8 @@ namespace Sass {
       // we do not include stdin for data contexts
       bool skip = c_ctx->type == SASS_CONTEXT_DATA;
 
+      // budgets count memory from here
+      cpp_ctx->interrupt.start_counting();
       // dispatch parse call
       Block_Obj root(cpp_ctx->parse());
       // abort on errors
@@ -315,9 +326,14 @@ extern "C" {
     Sass_Compiler* compiler = sass_prepare_context(c_ctx, cpp_ctx);
 
     try {
-      // call each compiler step
-      sass_compiler_parse(compiler);
-      sass_compiler_execute(compiler);
+      // serve unchanged results from the cache
+      ResultCache cache(*cpp_ctx, *c_ctx);
+      if (!cache.load()) {
+        // call each compiler step
+        sass_compiler_parse(compiler);
+        sass_compiler_execute(compiler);
+        cache.store();
+      }
     }
     // pass errors to generic error handler
     catch (...) { handle_errors(c_ctx); }
@@ -461,6 +477,18 @@ extern "C" {
     return 0;
   }
 
+  void ADDCALL sass_compiler_cancel(struct Sass_Compiler* compiler)
+  {
+    if (compiler == 0 || compiler->cpp_ctx == NULL) return;
+    compiler->cpp_ctx->interrupt.cancel();
+  }
+
+  void ADDCALL sass_compiler_set_deadline(struct Sass_Compiler* compiler, size_t milliseconds)
+  {
+    if (compiler == 0 || compiler->cpp_ctx == NULL) return;
+    compiler->cpp_ctx->interrupt.set_deadline(milliseconds);
+  }
+
   // helper function, not exported, only accessible locally
   static void sass_reset_options (struct Sass_Options* options)
   {
@@ -472,6 +500,7 @@ extern "C" {
     options->include_path = 0;
     options->source_map_file = 0;
     options->source_map_root = 0;
+    options->cache_path = 0;
     options->c_functions = 0;
     options->c_importers = 0;
     options->c_headers = 0;
@@ -518,6 +547,7 @@ extern "C" {
     free(options->include_path);
     free(options->source_map_file);
     free(options->source_map_root);
+    free(options->cache_path);
     // Reset our pointers
     options->input_path = 0;
     options->output_path = 0;
@@ -525,6 +555,7 @@ extern "C" {
     options->include_path = 0;
     options->source_map_file = 0;
     options->source_map_root = 0;
+    options->cache_path = 0;
     options->c_functions = 0;
     options->c_importers = 0;
     options->c_headers = 0;
@@ -569,6 +600,13 @@ extern "C" {
       return;
     }
     Context* cpp_ctx = compiler->cpp_ctx;
+    Sass_Context* c_ctx = compiler->c_ctx;
+    // remember what this compilation has loaded, data
+    // contexts have no path to be known under
+    if (cpp_ctx && c_ctx && c_ctx->dependency_graph && c_ctx->type == SASS_CONTEXT_FILE) {
+      try { c_ctx->dependency_graph->record(*cpp_ctx, c_ctx->error_status == 0); }
+      catch (...) { }
+    }
     if (cpp_ctx) delete(cpp_ctx);
     compiler->cpp_ctx = NULL;
     compiler->c_ctx = NULL;
@@ -621,6 +659,9 @@ extern "C" {
   Sass_Callee_Entry ADDCALL sass_compiler_get_last_callee(struct Sass_Compiler* compiler) { return &compiler->cpp_ctx->callee_stack.back(); }
   Sass_Callee_Entry ADDCALL sass_compiler_get_callee_entry(struct Sass_Compiler* compiler, size_t idx) { return &compiler->cpp_ctx->callee_stack[idx]; }
 
+  size_t ADDCALL sass_compiler_get_file_probes(struct Sass_Compiler* compiler) { return compiler->cpp_ctx->resolver_cache.probes(); }
+  size_t ADDCALL sass_compiler_get_file_probe_hits(struct Sass_Compiler* compiler) { return compiler->cpp_ctx->resolver_cache.hits(); }
+
   // Calculate the size of the stored null terminated array
   size_t ADDCALL sass_context_get_included_files_size (struct Sass_Context* ctx)
   { size_t l = 0; auto i = ctx->included_files; while (i && *i) { ++i; ++l; } return l; }
@@ -634,9 +675,17 @@ extern "C" {
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, source_map_file_urls);
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, omit_source_map_url);
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, is_indented_syntax_src);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, merge_media_queries);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, merge_rules);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, remove_duplicate_declarations);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, legacy_passes);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(size_t, max_memory);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(size_t, max_output_size);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(size_t, max_selector_permutations);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Function_List, c_functions);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Importer_List, c_importers);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Importer_List, c_headers);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(struct Sass_Dependency_Graph*, dependency_graph);
   IMPLEMENT_SASS_OPTION_ACCESSOR(const char*, indent);
   IMPLEMENT_SASS_OPTION_ACCESSOR(const char*, linefeed);
   IMPLEMENT_SASS_OPTION_STRING_SETTER(const char*, plugin_path, 0);
@@ -645,6 +694,7 @@ extern "C" {
   IMPLEMENT_SASS_OPTION_STRING_ACCESSOR(const char*, output_path, 0);
   IMPLEMENT_SASS_OPTION_STRING_ACCESSOR(const char*, source_map_file, 0);
   IMPLEMENT_SASS_OPTION_STRING_ACCESSOR(const char*, source_map_root, 0);
+  IMPLEMENT_SASS_OPTION_STRING_ACCESSOR(const char*, cache_path, 0);
 
   // Create getter and setters for context
   IMPLEMENT_SASS_CONTEXT_GETTER(int, error_status);
@@ -739,4 +789,38 @@ extern "C" {
 
   }
 
+
+  struct Sass_Dependency_Graph* ADDCALL sass_make_dependency_graph(void)
+  {
+    return new Sass_Dependency_Graph();
+  }
+
+  void ADDCALL sass_delete_dependency_graph(struct Sass_Dependency_Graph* graph)
+  {
+    delete graph;
+  }
+
+  char** ADDCALL sass_dependency_graph_get_affected_entries(struct Sass_Dependency_Graph* graph, const char** changed_files)
+  {
+    if (graph == 0) return 0;
+    try {
+      sass::vector<sass::string> changed;
+      while (changed_files && *changed_files) {
+        changed.push_back(*changed_files);
+        ++changed_files;
+      }
+      char** entries = 0;
+      copy_strings(graph->affected(changed), &entries);
+      return entries;
+    }
+    catch (...) { return 0; }
+  }
+
+  void ADDCALL sass_dependency_graph_forget_entry(struct Sass_Dependency_Graph* graph, const char* entry)
+  {
+    if (graph == 0 || entry == 0) return;
+    try { graph->forget(entry); }
+    catch (...) { }
+  }
+
 }
@@ -23,6 +23,28 @@ struct Sass_Options : Sass_Output_Options {
   // Treat source_string as sass (as opposed to scss)
   bool is_indented_syntax_src;
 
+  // Join adjacent media rules with equal queries
+  bool merge_media_queries;
+
+  // Merge adjacent rules with equal selectors or bodies
+  bool merge_rules;
+
+  // Drop declarations repeated later in the same rule
+  bool remove_duplicate_declarations;
+
+  // Run nesting checks and placeholder removal as
+  // separate passes over the whole tree, as before
+  bool legacy_passes;
+
+  // Budgets that stop a compile once used up,
+  // zero means there is no budget (the default)
+  // Bytes of nodes and values alive at once
+  size_t max_memory;
+  // Bytes of the css output
+  size_t max_output_size;
+  // Selectors one @extend may weave
+  size_t max_selector_permutations;
+
   // The input path is used for source map
   // generation. It can be used to define
   // something with string compilation or to
@@ -56,6 +78,10 @@ struct Sass_Options : Sass_Output_Options {
   // Directly inserted in source maps
   char* source_map_root;
 
+  // Directory to store compilation results
+  // Enables the result cache (opt-in)
+  char* cache_path;
+
   // Custom functions that can be called from sccs code
   Sass_Function_List c_functions;
 
@@ -65,6 +91,10 @@ struct Sass_Options : Sass_Output_Options {
   // List of custom headers
   Sass_Importer_List c_headers;
 
+  // Import graph updated after each compile
+  // Not owned, may be shared between contexts
+  struct Sass_Dependency_Graph* dependency_graph;
+
 };
 
 
@@ -53,6 +53,9 @@ extern "C" {
   Sass_Function_Fn ADDCALL sass_function_get_function(Sass_Function_Entry cb) { return cb->function; }
   void* ADDCALL sass_function_get_cookie(Sass_Function_Entry cb) { return cb->cookie; }
 
+  void ADDCALL sass_function_set_deterministic(Sass_Function_Entry cb, bool deterministic) { cb->deterministic = deterministic; }
+  bool ADDCALL sass_function_get_deterministic(Sass_Function_Entry cb) { return cb->deterministic; }
+
   Sass_Importer_Entry ADDCALL sass_make_importer(Sass_Importer_Fn importer, double priority, void* cookie)
   {
     Sass_Importer_Entry cb = (Sass_Importer_Entry) calloc(1, sizeof(Sass_Importer));
@@ -67,6 +70,12 @@ extern "C" {
   double ADDCALL sass_importer_get_priority (Sass_Importer_Entry cb) { return cb->priority; }
   void* ADDCALL sass_importer_get_cookie(Sass_Importer_Entry cb) { return cb->cookie; }
 
+  void ADDCALL sass_importer_set_prefetch(Sass_Importer_Entry cb, Sass_Importer_Prefetch_Fn prefetch) { cb->prefetch = prefetch; }
+  Sass_Importer_Prefetch_Fn ADDCALL sass_importer_get_prefetch(Sass_Importer_Entry cb) { return cb->prefetch; }
+
+  void ADDCALL sass_importer_set_deterministic(Sass_Importer_Entry cb, bool deterministic) { cb->deterministic = deterministic; }
+  bool ADDCALL sass_importer_get_deterministic(Sass_Importer_Entry cb) { return cb->deterministic; }
+
   // Just in case we have some stray import structs
   void ADDCALL sass_delete_importer (Sass_Importer_Entry cb)
   {
@@ -10,6 +10,7 @@ struct Sass_Function {
   char*            signature;
   Sass_Function_Fn function;
   void*            cookie;
+  bool             deterministic;
 };
 
 // External import entry
@@ -45,6 +46,8 @@ struct Sass_Importer {
   Sass_Importer_Fn importer;
   double           priority;
   void*            cookie;
+  Sass_Importer_Prefetch_Fn prefetch;
+  bool             deterministic;
 };
 
 #endif
\ No newline at end of file
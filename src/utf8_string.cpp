@@ -6,8 +6,10 @@
 #include <vector>
 #include <cstdlib>
 #include <cmath>
+#include <algorithm>
 
 #include "utf8.h"
+#include "utf8_string.hpp"
 
 namespace Sass {
   namespace UTF_8 {
@@ -71,6 +73,56 @@ namespace Sass {
       }
     }
 
+    // distance between two checkpoints, in code points
+    static const size_t checkpoint_step = 64;
+
+    CodePoints::CodePoints(const sass::string& str)
+    : ascii(true), length(0), checkpoints()
+    {
+      for (unsigned char c : str) {
+        if (c >= 0x80) { ascii = false; break; }
+      }
+      if (ascii) { length = str.size(); return; }
+      sass::string::const_iterator it = str.begin();
+      while (it != str.end()) {
+        if (length % checkpoint_step == 0) {
+          checkpoints.push_back(it - str.begin());
+        }
+        // validates the sequence
+        utf8::next(it, str.end());
+        ++length;
+      }
+    }
+
+    // function that will return the byte offset at a code point position
+    size_t CodePoints::offset_at_position(const sass::string& str, size_t position) const
+    {
+      if (position >= length) return str.size();
+      if (ascii) return position;
+      sass::string::const_iterator it = str.begin() + checkpoints[position / checkpoint_step];
+      // validated on construction
+      for (size_t i = position % checkpoint_step; i > 0; --i) utf8::unchecked::next(it);
+      return it - str.begin();
+    }
+
+    // function that will count the code points before a byte offset
+    size_t CodePoints::position_at_offset(const sass::string& str, size_t offset) const
+    {
+      if (ascii) return offset;
+      auto cp = std::upper_bound(checkpoints.begin(), checkpoints.end(), offset) - 1;
+      size_t position = (cp - checkpoints.begin()) * checkpoint_step;
+      // count every byte that starts a code point
+      for (size_t i = *cp; i < offset && i < str.size(); ++i) {
+        if ((static_cast<unsigned char>(str[i]) & 0xC0) != 0x80) ++position;
+      }
+      return position;
+    }
+
+    sass::string CodePoints::to_string() const
+    {
+      return std::to_string(length) + (ascii ? " ascii code points" : " code points");
+    }
+
     #ifdef _WIN32
 
     // utf16 functions
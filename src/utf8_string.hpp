@@ -26,6 +26,26 @@ namespace Sass {
     // function that will return a normalized index, given a crazy one
     size_t normalize_index(int index, size_t len);
 
+    // Converts between code point positions and byte offsets of one
+    // string without walking it from the start. Pure ascii strings
+    // need no table, others remember the offset of every 64th code
+    // point. Construction throws on invalid utf-8, like utf8::distance.
+    class CodePoints : public SharedObj {
+    public:
+      CodePoints(const sass::string& str);
+      bool is_ascii() const { return ascii; }
+      // number of code points in the string
+      size_t count() const { return length; }
+      // the string must be the one the table was built for
+      size_t offset_at_position(const sass::string& str, size_t position) const;
+      size_t position_at_offset(const sass::string& str, size_t offset) const;
+      sass::string to_string() const override;
+    private:
+      bool ascii;
+      size_t length;
+      sass::vector<size_t> checkpoints;
+    };
+
     #ifdef _WIN32
     // functions to handle unicode paths on windows
     sass::string convert_from_utf16(const std::wstring& wstr);
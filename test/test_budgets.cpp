@@ -0,0 +1,99 @@
+#include "test_helpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+Set_Options budgets(size_t memory, size_t output, size_t permutations) {
+  return [=](struct Sass_Options* options) {
+    sass_option_set_max_memory(options, memory);
+    sass_option_set_max_output_size(options, output);
+    sass_option_set_max_selector_permutations(options, permutations);
+  };
+}
+
+bool expect_exceeded(const char* source, const Set_Options& limits, const std::string& message) {
+  std::string result;
+  int status = compile(source, limits, result);
+  if (status == 7 && result == "Error: " + message + "\n") return true;
+  std::cerr << "Expected status 7 and " << message << ", got "
+            << status << ": " << result << std::endl;
+  return false;
+}
+
+// many rules, each of them with its own values
+const char* many_rules =
+  "@for $i from 1 through 2000 { .a-#{$i} { b: $i * 1px; c: 'c#{$i}'; } }\n";
+
+// each extend doubles the selectors of the rule
+const char* exponential_extend =
+  ".a1 .b1 .c1 .d1 { x: y; }\n"
+  ".e1 .f1 { @extend .a1; }\n.e2 .f2 { @extend .b1; }\n"
+  ".e3 .f3 { @extend .c1; }\n.e4 .f4 { @extend .d1; }\n";
+
+}  // namespace
+
+bool TestBudgetsOffByDefault() {
+  std::string result;
+  return compile(many_rules, budgets(0, 0, 0), result) == 0
+    && compile(exponential_extend, budgets(0, 0, 0), result) == 0;
+}
+
+bool TestBudgetsNotReached() {
+  return expect(".a { b: c; } .d { @extend .a; }\n",
+    budgets(1000000000, 1000000, 100000), ".a,.d{b:c}\n");
+}
+
+bool TestMemoryBudget() {
+  std::string result;
+  if (compile(many_rules, budgets(100000, 0, 0), result) != 7) {
+    std::cerr << "Expected status 7, got " << result << std::endl;
+    return false;
+  }
+  return result.find("Error: Compilation used ") == 0 && result.find(
+    "bytes, more than its memory budget of 100000 bytes\n") != std::string::npos;
+}
+
+bool TestOutputBudget() {
+  std::string result;
+  if (compile(many_rules, budgets(0, 10000, 0), result) != 7) {
+    std::cerr << "Expected status 7, got " << result << std::endl;
+    return false;
+  }
+  return result.find("Error: Compilation wrote ") == 0 && result.find(
+    "bytes, more than its output budget of 10000 bytes\n") != std::string::npos
+    && expect_exceeded(".a { b: c; }\n", budgets(0, 5, 0),
+      "Compilation wrote 8 bytes, more than its output budget of 5 bytes");
+}
+
+bool TestPermutationBudget() {
+  return expect_exceeded(exponential_extend, budgets(0, 0, 10),
+    "Extending \".e1 .f1 .b1 .c1 .d1\" needs more than 10 selector permutations")
+    // weaving the parents gives two orders
+    && expect_exceeded(".a .b .c .d .e { x: y; }\n.f .g .h .i .j { @extend .e; }\n", budgets(0, 0, 1),
+    "Extending \".a .b .c .d .e\" needs more than 1 selector permutations");
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestBudgetsOffByDefault);
+  TEST(TestBudgetsNotReached);
+  TEST(TestMemoryBudget);
+  TEST(TestOutputBudget);
+  TEST(TestPermutationBudget);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
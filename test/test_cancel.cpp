@@ -0,0 +1,123 @@
+#include "sass.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// runs until it is stopped
+const char* endless_rules =
+  "$i: 0;\n"
+  "@while $i >= 0 { .a-#{$i % 10} { b: $i; } $i: $i + 1; }\n";
+
+const char* endless_function =
+  "@function f() { $i: 0; @while true { $i: $i + 1; } @return $i; }\n"
+  ".a { b: f(); }\n";
+
+struct Compile {
+  struct Sass_Data_Context* data_ctx;
+  struct Sass_Context* ctx;
+  struct Sass_Compiler* compiler;
+
+  Compile(const char* source) {
+    data_ctx = sass_make_data_context(sass_copy_c_string(source));
+    ctx = sass_data_context_get_context(data_ctx);
+    compiler = sass_make_data_compiler(data_ctx);
+  }
+
+  ~Compile() {
+    sass_delete_compiler(compiler);
+    sass_delete_data_context(data_ctx);
+  }
+
+  // error status and how long the compile took
+  int execute(double& seconds) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    sass_compiler_parse(compiler);
+    sass_compiler_execute(compiler);
+    std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+    seconds = took.count();
+    return sass_context_get_error_status(ctx);
+  }
+};
+
+bool expect_stop(Compile& compile, const std::string& message) {
+  double seconds;
+  int status = compile.execute(seconds);
+  std::string error = sass_context_get_error_message(compile.ctx)
+    ? sass_context_get_error_message(compile.ctx) : "";
+  if (status != 6 || error != "Error: " + message + "\n") {
+    std::cerr << "Expected status 6, got " << status << ": " << error << std::endl;
+    return false;
+  }
+  if (seconds > 5) {
+    std::cerr << "Took " << seconds << " seconds to stop" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool TestDeadlineInRules() {
+  Compile compile(endless_rules);
+  sass_compiler_set_deadline(compile.compiler, 50);
+  return expect_stop(compile, "Compilation exceeded its deadline");
+}
+
+bool TestDeadlineInFunction() {
+  Compile compile(endless_function);
+  sass_compiler_set_deadline(compile.compiler, 50);
+  return expect_stop(compile, "Compilation exceeded its deadline");
+}
+
+bool TestCancelFromThread() {
+  Compile compile(endless_rules);
+  std::thread canceller([&compile]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sass_compiler_cancel(compile.compiler);
+  });
+  bool stopped = expect_stop(compile, "Compilation cancelled");
+  canceller.join();
+  return stopped;
+}
+
+bool TestCancelBeforeExecute() {
+  Compile compile(".a { b: c; }\n");
+  sass_compiler_cancel(compile.compiler);
+  return expect_stop(compile, "Compilation cancelled");
+}
+
+bool TestDeadlineNotReached() {
+  Compile compile(".a { @for $i from 1 through 3 { b-#{$i}: c; } }\n");
+  sass_compiler_set_deadline(compile.compiler, 60000);
+  double seconds;
+  if (compile.execute(seconds) != 0) return false;
+  std::string css = sass_context_get_output_string(compile.ctx);
+  return css == ".a {\n  b-1: c;\n  b-2: c;\n  b-3: c; }\n";
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestDeadlineInRules);
+  TEST(TestDeadlineInFunction);
+  TEST(TestCancelFromThread);
+  TEST(TestCancelBeforeExecute);
+  TEST(TestDeadlineNotReached);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
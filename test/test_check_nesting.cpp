@@ -0,0 +1,78 @@
+#include "test_helpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+Set_Options legacy_passes(bool legacy) {
+  return [=](struct Sass_Options* options) {
+    sass_option_set_legacy_passes(options, legacy);
+  };
+}
+
+// both ways must give the same css or the same error
+bool same_as_legacy(const char* source, const std::string& expected) {
+  std::string css = compile(source, legacy_passes(false));
+  if (!expect_equal(css, compile(source, legacy_passes(true)))) return false;
+  // errors are only compared up to their position
+  if (css.compare(0, expected.size(), expected) == 0) return true;
+  return expect_equal(css, expected);
+}
+
+}  // namespace
+
+bool TestPlaceholdersRemoved() {
+  return same_as_legacy(
+    "%p { a: b; } .x { @extend %p; } %q { c: d; } .y %q, .z { e: f; }\n"
+    "@media print { %r, .s { g: h; } }\n",
+    ".x{a:b}.z{e:f}@media print{.s{g:h}}\n");
+}
+
+bool TestDeclarationsUnderAtRoot() {
+  return same_as_legacy(
+    ".a { @at-root { b: c; } }\n",
+    "Error: Properties are only allowed within rules, directives, mixin includes, or other properties.");
+}
+
+bool TestDeclarationsFromMixin() {
+  return same_as_legacy(
+    "@mixin m { x: y; }\n.a { @include m; }\n@include m;\n",
+    "Error: Properties are only allowed within rules, directives, mixin includes, or other properties.");
+}
+
+bool TestNestedProperties() {
+  return same_as_legacy(
+    ".a { font: { family: x; .b { c: d; } } }\n",
+    "Error: Illegal nesting: Only properties may be nested beneath properties.")
+    && same_as_legacy(".a { font: { family: x; size: 1px; } }\n",
+    ".a{font-family:x;font-size:1px}\n");
+}
+
+bool TestInvalidValues() {
+  return same_as_legacy(".a { b: (c: d); }\n", "Error: (c: d) isn't a valid CSS value.")
+    && same_as_legacy(".a { b: 1px*1px; }\n", "Error: 1px*px isn't a valid CSS value.");
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestPlaceholdersRemoved);
+  TEST(TestDeclarationsUnderAtRoot);
+  TEST(TestDeclarationsFromMixin);
+  TEST(TestNestedProperties);
+  TEST(TestInvalidValues);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
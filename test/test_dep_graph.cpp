@@ -0,0 +1,167 @@
+#include "test_helpers.hpp"
+
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+const Fixture files("dep_graph");
+
+bool compile(struct Sass_Dependency_Graph* graph, const std::string& name,
+             const std::string& include_path = "") {
+  struct Sass_File_Context* file_ctx = sass_make_file_context((files.dir + name).c_str());
+  struct Sass_Options* options = sass_file_context_get_options(file_ctx);
+  sass_option_set_dependency_graph(options, graph);
+  sass_option_set_include_path(options, include_path.c_str());
+  bool ok = sass_compile_file_context(file_ctx) == 0;
+  sass_delete_file_context(file_ctx);
+  return ok;
+}
+
+// entry file names (without directory) affected by the changed files
+std::set<std::string> affected(struct Sass_Dependency_Graph* graph,
+                               std::vector<std::string> changed) {
+  std::vector<std::string> paths;
+  std::vector<const char*> list;
+  for (const std::string& name : changed) paths.push_back(files.dir + name);
+  for (const std::string& path : paths) list.push_back(path.c_str());
+  list.push_back(nullptr);
+  std::set<std::string> entries;
+  char** result = sass_dependency_graph_get_affected_entries(graph, list.data());
+  for (char** entry = result; entry && *entry; ++entry) {
+    std::string path(*entry);
+    entries.insert(path.substr(path.rfind('/') + 1));
+    sass_free_memory(*entry);
+  }
+  sass_free_memory(result);
+  return entries;
+}
+
+bool expect(const std::set<std::string>& actual, const std::set<std::string>& expected) {
+  if (actual == expected) return true;
+  std::cerr << "Expected {";
+  for (const std::string& s : expected) std::cerr << " " << s;
+  std::cerr << " } but got {";
+  for (const std::string& s : actual) std::cerr << " " << s;
+  std::cerr << " }" << std::endl;
+  return false;
+}
+
+void setup() {
+  files.reset({ "inc" });
+  files.write("_colors.scss", "$main: red;\n");
+  files.write("_mixins.scss", "@import 'colors';\n@mixin m { color: $main; }\n");
+  files.write("_unused.scss", "$x: 1;\n");
+  files.write("a.scss", "@import 'mixins';\na { @include m; }\n");
+  files.write("b.scss", "@import 'colors';\nb { color: $main; }\n");
+  files.write("c.scss", "c { color: blue; }\n");
+}
+
+}  // namespace
+
+bool TestAffectedEntries() {
+  setup();
+  struct Sass_Dependency_Graph* graph = sass_make_dependency_graph();
+  bool ok = compile(graph, "a.scss") && compile(graph, "b.scss") && compile(graph, "c.scss");
+  // touching a file without changing it needs no rebuild
+  ok = ok && expect(affected(graph, {"_colors.scss", "c.scss"}), {});
+  files.write("_colors.scss", "$main: green;\n");
+  ok = ok && expect(affected(graph, {"_colors.scss"}), {"a.scss", "b.scss"});
+  files.write("_mixins.scss", "@mixin m { color: blue; }\n");
+  ok = ok && expect(affected(graph, {"_mixins.scss", "_unused.scss"}), {"a.scss"});
+  // after recompiling, a no longer depends on colors
+  ok = ok && compile(graph, "a.scss") && compile(graph, "b.scss");
+  files.write("_colors.scss", "$main: blue;\n");
+  ok = ok && expect(affected(graph, {"_colors.scss"}), {"b.scss"});
+  // a forgotten entry is never reported
+  sass_dependency_graph_forget_entry(graph, (files.dir + "b.scss").c_str());
+  ok = ok && expect(affected(graph, {"_colors.scss"}), {});
+  sass_delete_dependency_graph(graph);
+  return ok;
+}
+
+bool TestFailedEntries() {
+  setup();
+  struct Sass_Dependency_Graph* graph = sass_make_dependency_graph();
+  files.write("b.scss", "@import 'colors';\nb { color: $missing; }\n");
+  bool ok = !compile(graph, "b.scss");
+  // broken entries are retried on any change of what they loaded
+  ok = ok && expect(affected(graph, {"_colors.scss"}), {"b.scss"});
+  files.write("b.scss", "@import 'colors';\nb { color: $main; }\n");
+  ok = ok && compile(graph, "b.scss");
+  ok = ok && expect(affected(graph, {"_colors.scss"}), {});
+  sass_delete_dependency_graph(graph);
+  return ok;
+}
+
+bool TestMissingImports() {
+  setup();
+  struct Sass_Dependency_Graph* graph = sass_make_dependency_graph();
+  files.write("d.scss", "@import 'later';\nd { color: $later; }\n");
+  bool ok = !compile(graph, "d.scss");
+  // creating the missing partial fixes the entry
+  files.write("_later.scss", "$later: red;\n");
+  ok = ok && expect(affected(graph, {"_later.scss", "_unused.scss"}), {"d.scss"});
+  ok = ok && compile(graph, "d.scss");
+  ok = ok && expect(affected(graph, {"_later.scss"}), {});
+  sass_delete_dependency_graph(graph);
+  return ok;
+}
+
+bool TestShadowedImports() {
+  setup();
+  struct Sass_Dependency_Graph* graph = sass_make_dependency_graph();
+  files.write("inc/_theme.scss", "$theme: red;\n");
+  files.write("e.scss", "@import 'theme';\ne { color: $theme; }\n");
+  std::string paths = files.dir + "extra:" + files.dir + "inc";
+  bool ok = compile(graph, "e.scss", paths);
+  // a partial next to the entry wins over the include path
+  files.write("_theme.scss", "$theme: blue;\n");
+  ok = ok && expect(affected(graph, {"_theme.scss"}), {"e.scss"});
+  files.remove("_theme.scss");
+  // so does one in an earlier include path that was missing
+  files.mkdir("extra");
+  files.write("extra/_theme.scss", "$theme: blue;\n");
+  ok = ok && expect(affected(graph, {"extra/_theme.scss"}), {"e.scss"});
+  sass_delete_dependency_graph(graph);
+  return ok;
+}
+
+bool TestDataContextsNotRecorded() {
+  setup();
+  struct Sass_Dependency_Graph* graph = sass_make_dependency_graph();
+  struct Sass_Data_Context* data_ctx = sass_make_data_context(sass_copy_c_string("@import 'colors';\n"));
+  struct Sass_Options* options = sass_data_context_get_options(data_ctx);
+  sass_option_set_dependency_graph(options, graph);
+  sass_option_set_include_path(options, files.dir.c_str());
+  bool ok = sass_compile_data_context(data_ctx) == 0;
+  sass_delete_data_context(data_ctx);
+  files.write("_colors.scss", "$main: green;\n");
+  ok = ok && expect(affected(graph, {"_colors.scss"}), {});
+  sass_delete_dependency_graph(graph);
+  return ok;
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestAffectedEntries);
+  TEST(TestFailedEntries);
+  TEST(TestMissingImports);
+  TEST(TestShadowedImports);
+  TEST(TestDataContextsNotRecorded);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
@@ -0,0 +1,94 @@
+#ifndef SASS_TEST_HELPERS_H
+#define SASS_TEST_HELPERS_H
+
+#include "sass.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// sets the options a test needs, the output style is compressed
+typedef std::function<void(struct Sass_Options*)> Set_Options;
+
+// compiles source as a data context and returns the error status,
+// result is the css or the error message
+inline int compile(const char* source, const Set_Options& set_options, std::string& result) {
+  struct Sass_Data_Context* data_ctx = sass_make_data_context(sass_copy_c_string(source));
+  struct Sass_Context* ctx = sass_data_context_get_context(data_ctx);
+  struct Sass_Options* options = sass_context_get_options(ctx);
+  sass_option_set_output_style(options, SASS_STYLE_COMPRESSED);
+  set_options(options);
+  int status = sass_compile_data_context(data_ctx);
+  result = status == 0
+    ? sass_context_get_output_string(ctx) : sass_context_get_error_message(ctx);
+  status = sass_context_get_error_status(ctx);
+  sass_delete_data_context(data_ctx);
+  return status;
+}
+
+// the css or the error message
+inline std::string compile(const char* source, const Set_Options& set_options) {
+  std::string result;
+  compile(source, set_options, result);
+  return result;
+}
+
+inline bool expect_equal(const std::string& actual, const std::string& expected) {
+  if (actual == expected) return true;
+  std::cerr << "Expected " << expected << "got " << actual;
+  return false;
+}
+
+inline bool expect(const char* source, const Set_Options& set_options, const std::string& expected) {
+  return expect_equal(compile(source, set_options), expected);
+}
+
+// removes a file or a directory with everything below it
+inline void remove_tree(const std::string& path) {
+  DIR* dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    std::remove(path.c_str());
+    return;
+  }
+  while (struct dirent* entry = readdir(dir)) {
+    std::string name(entry->d_name);
+    if (name != "." && name != "..") remove_tree(path + "/" + name);
+  }
+  closedir(dir);
+  rmdir(path.c_str());
+}
+
+// the files a test compiles from disk, kept below build/<name>/
+struct Fixture {
+  const std::string dir;
+
+  explicit Fixture(const std::string& name) : dir("build/" + name + "/") { }
+
+  // starts over with an empty directory and the given subdirectories
+  void reset(const std::vector<std::string>& subdirs = {}) const {
+    remove_tree(dir.substr(0, dir.size() - 1));
+    ::mkdir(dir.c_str(), 0777);
+    for (const std::string& subdir : subdirs) mkdir(subdir);
+  }
+
+  void mkdir(const std::string& name) const {
+    ::mkdir((dir + name).c_str(), 0777);
+  }
+
+  void write(const std::string& name, const std::string& contents) const {
+    std::ofstream(dir + name) << contents;
+  }
+
+  void remove(const std::string& name) const {
+    std::remove((dir + name).c_str());
+  }
+};
+
+#endif
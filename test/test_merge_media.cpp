@@ -0,0 +1,63 @@
+#include "test_helpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+Set_Options merge(bool merge_media_queries) {
+  return [=](struct Sass_Options* options) {
+    sass_option_set_merge_media_queries(options, merge_media_queries);
+  };
+}
+
+const char* mixins =
+  "@mixin bp { @media (min-width: 10px) { @content; } }\n"
+  ".a { @include bp { x: 1; } }\n"
+  ".b { @include bp { x: 2; } }\n";
+
+}  // namespace
+
+bool TestMergeIsOptIn() {
+  return expect(mixins, merge(false),
+    "@media (min-width: 10px){.a{x:1}}@media (min-width: 10px){.b{x:2}}\n");
+}
+
+bool TestMergeAdjacent() {
+  return expect(mixins, merge(true),
+    "@media (min-width: 10px){.a{x:1}.b{x:2}}\n");
+}
+
+bool TestMergeKeepsOrder() {
+  // joining across another rule would change the cascade
+  return expect(
+    "@media print { .a { x: 1; } }\n"
+    "@media screen { .a { x: 2; } }\n"
+    "@media print { .a { x: 3; } }\n"
+    "@media print { .b { x: 4; } }\n"
+    "@supports (x: y) { @media print { .c { x: 5; } } @media print { .d { x: 6; } } }\n",
+    merge(true),
+    "@media print{.a{x:1}}@media screen{.a{x:2}}@media print{.a{x:3}.b{x:4}}"
+    "@supports (x: y){@media print{.c{x:5}.d{x:6}}}\n");
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestMergeIsOptIn);
+  TEST(TestMergeAdjacent);
+  TEST(TestMergeKeepsOrder);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
@@ -0,0 +1,100 @@
+#include "test_helpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+Set_Options passes(bool merge_rules, bool remove_duplicates) {
+  return [=](struct Sass_Options* options) {
+    sass_option_set_merge_rules(options, merge_rules);
+    sass_option_set_remove_duplicate_declarations(options, remove_duplicates);
+  };
+}
+
+}  // namespace
+
+bool TestMergeEqualSelectors() {
+  return expect(
+    ".a { x: 1; }\n.a { y: 2; }\n.b { x: 1; }\n.a { z: 3; }\n",
+    passes(true, false),
+    ".a{x:1;y:2}.b{x:1}.a{z:3}\n");
+}
+
+bool TestMergeEqualBodies() {
+  return expect(
+    "@mixin m { x: 1; y: 2; }\n"
+    ".a { @include m; }\n.b { @include m; }\n.a { @include m; }\n.c { y: 2; x: 1; }\n",
+    passes(true, false),
+    ".a,.b{x:1;y:2}.c{y:2;x:1}\n");
+}
+
+bool TestKeepVendorPrefixedSelectorsApart() {
+  return expect(
+    "::-moz-selection { x: 1; }\n::selection { x: 1; }\n",
+    passes(true, false),
+    "::-moz-selection{x:1}::selection{x:1}\n");
+}
+
+bool TestKeepNewerSelectorsApart() {
+  return expect(
+    ".a { outline: 0; }\n.b:focus-visible { outline: 0; }\n"
+    ".c { x: 1; }\n.d:not(.e .f) { x: 1; }\n.g { y: 2; }\n[h=i i] { y: 2; }\n",
+    passes(true, false),
+    ".a{outline:0}.b:focus-visible{outline:0}.c{x:1}.d:not(.e .f){x:1}.g{y:2}[h=i i]{y:2}\n");
+}
+
+bool TestMergeWidelySupportedSelectors() {
+  return expect(
+    "a:hover { x: 1; }\n.b > li:nth-child(2n+1) { x: 1; }\n#c:not(.d)::before { x: 1; }\n[e=f] + .g { x: 1; }\n",
+    passes(true, false),
+    "a:hover,.b>li:nth-child(2n+1),#c:not(.d)::before,[e=f]+.g{x:1}\n");
+}
+
+bool TestPlaceholdersDoNotSeparateRules() {
+  return expect(
+    ".a { x: 1; }\n%p { y: 2; }\n.a { z: 3; }\n",
+    passes(true, false),
+    ".a{x:1;z:3}\n");
+}
+
+bool TestRemoveDuplicateDeclarations() {
+  // fallbacks with other values or importance stay
+  return expect(
+    ".a { x: 1; y: 2; x: 1; y: 3; z: 4 !important; z: 4; }\n",
+    passes(false, true),
+    ".a{y:2;x:1;y:3;z:4 !important;z:4}\n");
+}
+
+bool TestOptimizationsAreOptIn() {
+  return expect(
+    ".a { x: 1; x: 1; }\n.a { y: 2; }\n",
+    passes(false, false),
+    ".a{x:1;x:1}.a{y:2}\n");
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestMergeEqualSelectors);
+  TEST(TestMergeEqualBodies);
+  TEST(TestKeepVendorPrefixedSelectorsApart);
+  TEST(TestKeepNewerSelectorsApart);
+  TEST(TestMergeWidelySupportedSelectors);
+  TEST(TestPlaceholdersDoNotSeparateRules);
+  TEST(TestRemoveDuplicateDeclarations);
+  TEST(TestOptimizationsAreOptIn);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
@@ -0,0 +1,119 @@
+#include "sass.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::vector<std::vector<std::string>> Batches;
+
+void prefetch(const char** urls, Sass_Importer_Entry cb, struct Sass_Compiler* compiler) {
+  Batches* batches = static_cast<Batches*>(sass_importer_get_cookie(cb));
+  batches->push_back(std::vector<std::string>());
+  while (*urls) batches->back().push_back(*urls++);
+}
+
+// serves every import from memory, "nested" imports "deep"
+Sass_Import_List importer(const char* url, Sass_Importer_Entry cb, struct Sass_Compiler* compiler) {
+  std::string source = std::string(url) == "nested"
+    ? "@import 'deep';\n" : "." + std::string(url) + " { x: y; }\n";
+  Sass_Import_List list = sass_make_import_list(1);
+  list[0] = sass_make_import_entry(url, sass_copy_c_string(source.c_str()), 0);
+  return list;
+}
+
+// the batches the hook received while compiling source
+Batches compile(const char* source, std::string& css) {
+  Batches batches;
+  struct Sass_Data_Context* data_ctx = sass_make_data_context(sass_copy_c_string(source));
+  struct Sass_Context* ctx = sass_data_context_get_context(data_ctx);
+  struct Sass_Options* options = sass_context_get_options(ctx);
+  sass_option_set_output_style(options, SASS_STYLE_COMPRESSED);
+  Sass_Importer_List importers = sass_make_importer_list(1);
+  Sass_Importer_Entry entry = sass_make_importer(importer, 0, &batches);
+  sass_importer_set_prefetch(entry, prefetch);
+  sass_importer_set_list_entry(importers, 0, entry);
+  sass_option_set_c_importers(options, importers);
+  css = sass_compile_data_context(data_ctx) == 0
+    ? sass_context_get_output_string(ctx) : sass_context_get_error_message(ctx);
+  sass_delete_data_context(data_ctx);
+  return batches;
+}
+
+std::string join(const std::vector<std::string>& urls) {
+  std::string joined;
+  for (const std::string& url : urls) joined += (joined.empty() ? "" : " ") + url;
+  return "{ " + joined + " }";
+}
+
+bool expect(const char* source, const Batches& expected, const std::string& expected_css) {
+  std::string css;
+  Batches batches = compile(source, css);
+  if (css != expected_css) {
+    std::cerr << "Expected " << expected_css << "got " << css;
+    return false;
+  }
+  bool same = batches.size() == expected.size();
+  for (size_t i = 0; same && i < batches.size(); ++i) same = batches[i] == expected[i];
+  if (same) return true;
+  std::cerr << "Expected";
+  for (const std::vector<std::string>& batch : expected) std::cerr << " " << join(batch);
+  std::cerr << " but got";
+  for (const std::vector<std::string>& batch : batches) std::cerr << " " << join(batch);
+  std::cerr << std::endl;
+  return false;
+}
+
+}  // namespace
+
+bool TestCommaSeparatedImports() {
+  return expect("@import 'a', \"b\" , 'c';\n",
+    { { "a", "b", "c" } }, ".a{x:y}.b{x:y}.c{x:y}\n");
+}
+
+bool TestCommentsAndStringsSkipped() {
+  return expect(
+    "// @import 'line';\n"
+    "/* @import 'block'; */\n"
+    ".q { content: \"@import 'quoted'\"; }\n"
+    "@import /* between */ 'a';\n",
+    { { "a" } }, ".q{content:\"@import 'quoted'\"}.a{x:y}\n");
+}
+
+bool TestInterpolatedDropped() {
+  // the importer still gets the evaluated url later
+  return expect("$n: b;\n@import 'a', 'x-#{$n}';\n",
+    { { "a" } }, ".a{x:y}.x-b{x:y}\n");
+}
+
+bool TestNestedPartial() {
+  return expect("@import 'a';\n@import 'nested';\n",
+    { { "a", "nested" }, { "deep" } }, ".a{x:y}.deep{x:y}\n");
+}
+
+bool TestNoImports() {
+  return expect(".a { b: c; }\n", { }, ".a{b:c}\n");
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestCommaSeparatedImports);
+  TEST(TestCommentsAndStringsSkipped);
+  TEST(TestInterpolatedDropped);
+  TEST(TestNestedPartial);
+  TEST(TestNoImports);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
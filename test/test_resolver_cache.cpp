@@ -0,0 +1,95 @@
+#include "test_helpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const Fixture files("resolver_cache");
+
+struct Probes {
+  size_t probes;
+  size_t hits;
+};
+
+// file system probes made while compiling the given entry
+bool compile(const std::string& name, const std::string& include_path, Probes& probes) {
+  struct Sass_File_Context* file_ctx = sass_make_file_context((files.dir + name).c_str());
+  struct Sass_Context* ctx = sass_file_context_get_context(file_ctx);
+  struct Sass_Options* options = sass_context_get_options(ctx);
+  sass_option_set_include_path(options, include_path.c_str());
+  struct Sass_Compiler* compiler = sass_make_file_compiler(file_ctx);
+  sass_compiler_parse(compiler);
+  sass_compiler_execute(compiler);
+  probes.probes = sass_compiler_get_file_probes(compiler);
+  probes.hits = sass_compiler_get_file_probe_hits(compiler);
+  sass_delete_compiler(compiler);
+  bool ok = sass_context_get_error_status(ctx) == 0;
+  if (!ok) std::cerr << sass_context_get_error_message(ctx);
+  sass_delete_file_context(file_ctx);
+  return ok;
+}
+
+bool expect(const Probes& actual, const Probes& expected) {
+  if (actual.probes == expected.probes && actual.hits == expected.hits) return true;
+  std::cerr << "Expected " << expected.probes << " probes and " << expected.hits
+            << " hits, got " << actual.probes << " and " << actual.hits << std::endl;
+  return false;
+}
+
+// include paths that must be searched before the one with the partial
+std::string include_paths() {
+  std::string paths;
+  for (const char* missing : { "a", "b", "c" }) paths += files.dir + missing + ":";
+  return paths + files.dir + "found";
+}
+
+}  // namespace
+
+bool TestNoImports() {
+  files.reset({ "found" });
+  files.write("plain.scss", ".a { b: c; }\n");
+  Probes probes;
+  return compile("plain.scss", include_paths(), probes) && expect(probes, { 0, 0 });
+}
+
+bool TestMissingIncludePaths() {
+  files.reset({ "found" });
+  files.write("main.scss", "@import 'colors';\n");
+  files.write("found/_colors.scss", ".a { b: c; }\n");
+  Probes probes;
+  // next to the entry: the directory, eight candidates and the
+  // index directory; a single probe for each missing include
+  // path; the directory and eight candidates where it is found
+  return compile("main.scss", include_paths(), probes) && expect(probes, { 10 + 3 + 9, 0 });
+}
+
+bool TestRepeatedImport() {
+  files.reset({ "found" });
+  files.write("main.scss", "@import 'colors';\n.x { @import 'colors'; }\n");
+  files.write("found/_colors.scss", ".a { b: c; }\n");
+  Probes probes;
+  // the second import is answered from memory
+  return compile("main.scss", include_paths(), probes) && expect(probes, { 22, 22 });
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestNoImports);
+  TEST(TestMissingIncludePaths);
+  TEST(TestRepeatedImport);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
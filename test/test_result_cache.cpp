@@ -0,0 +1,115 @@
+#include "test_helpers.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const Fixture files("result_cache");
+
+// number of calls to the custom function, tells hits from misses
+int calls = 0;
+
+union Sass_Value* count_calls(const union Sass_Value* args, Sass_Function_Entry cb, struct Sass_Compiler* comp) {
+  ++calls;
+  return sass_make_number(calls, "px");
+}
+
+struct Result {
+  bool ok;
+  bool hit;
+  std::string css;
+  size_t included;
+};
+
+Result compile(const std::string& name, bool deterministic = true) {
+  struct Sass_File_Context* file_ctx = sass_make_file_context((files.dir + name).c_str());
+  struct Sass_Context* ctx = sass_file_context_get_context(file_ctx);
+  struct Sass_Options* options = sass_file_context_get_options(file_ctx);
+  sass_option_set_cache_path(options, (files.dir + "cache").c_str());
+  sass_option_set_include_path(options, (files.dir + "lib").c_str());
+  Sass_Function_List fns = sass_make_function_list(1);
+  fns[0] = sass_make_function("count()", count_calls, 0);
+  sass_function_set_deterministic(fns[0], deterministic);
+  sass_option_set_c_functions(options, fns);
+  int before = calls;
+  Result result;
+  result.ok = sass_compile_file_context(file_ctx) == 0;
+  result.hit = calls == before;
+  result.css = result.ok ? sass_context_get_output_string(ctx) : "";
+  result.included = sass_context_get_included_files_size(ctx);
+  sass_delete_file_context(file_ctx);
+  return result;
+}
+
+bool expect(const Result& result, bool hit, const char* what) {
+  if (result.ok && result.hit == hit) return true;
+  std::cerr << what << ": expected a " << (hit ? "hit" : "miss")
+            << (result.ok ? "" : " but the compile failed") << std::endl;
+  return false;
+}
+
+void setup() {
+  files.reset({ "cache", "lib" });
+  files.write("lib/_vars.scss", "$w: 10px;\n");
+  files.write("a.scss", "@import 'vars';\na { width: $w; n: count(); }\n");
+}
+
+}  // namespace
+
+bool TestCacheHits() {
+  setup();
+  Result first = compile("a.scss");
+  bool ok = expect(first, false, "first compile");
+  Result second = compile("a.scss");
+  ok = ok && expect(second, true, "unchanged inputs");
+  ok = ok && second.css == first.css && second.included == first.included;
+  files.write("lib/_vars.scss", "$w: 20px;\n");
+  ok = ok && expect(compile("a.scss"), false, "changed import");
+  ok = ok && expect(compile("a.scss"), true, "recompiled import");
+  // a new candidate wins the import resolution
+  files.write("_vars.scss", "$w: 30px;\n");
+  Result shadowed = compile("a.scss");
+  ok = ok && expect(shadowed, false, "new import candidate");
+  ok = ok && shadowed.css.find("30px") != std::string::npos;
+  return ok;
+}
+
+bool TestUncacheableCompiles() {
+  setup();
+  // functions must declare themselves deterministic
+  bool ok = expect(compile("a.scss", false), false, "first compile");
+  ok = ok && expect(compile("a.scss", false), false, "nondeterministic function");
+  // results using random values are not stored
+  files.write("b.scss", "b { n: count(); r: random(); }\n");
+  ok = ok && expect(compile("b.scss"), false, "first random compile");
+  ok = ok && expect(compile("b.scss"), false, "random function");
+  // a cached result would not print the warnings again
+  files.write("c.scss", "c { n: count(); }\n@warn 'careful';\n");
+  ok = ok && expect(compile("c.scss"), false, "first warning compile");
+  ok = ok && expect(compile("c.scss"), false, "warning");
+  files.write("d.scss", "d { n: count(); }\n@debug 'here';\n");
+  ok = ok && expect(compile("d.scss"), false, "first debug compile");
+  ok = ok && expect(compile("d.scss"), false, "debug output");
+  return ok;
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestCacheHits);
+  TEST(TestUncacheableCompiles);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
@@ -136,6 +136,21 @@ bool TestDetachNull() {
   return true;
 }
 
+bool TestIsShared() {
+  bool destroyed = false;
+  {
+    SharedTestObj a = SASS_MEMORY_NEW(TestObj, &destroyed);
+    ASSERT(!a->isShared());
+    {
+      SharedTestObj b = a;
+      ASSERT(a->isShared());
+    }
+    ASSERT(!a->isShared());
+  }
+  ASSERT(destroyed);
+  return true;
+}
+
 class EmptyTestObj : public Sass::SharedObj {
   public:
     Sass::sass::string to_string() const { return ""; }
@@ -182,6 +197,7 @@ int main(int argc, char **argv) {
   TEST(TestSelfAssignDetach);
   TEST(TestDetachedPtrIsNotDestroyedUntilAssignment);
   TEST(TestDetachNull);
+  TEST(TestIsShared);
   TEST(TestComparisonWithSharedPtr);
   TEST(TestComparisonWithNullptr);
   std::cerr << argv[0] << ": Passed: " << passed.size()
@@ -0,0 +1,113 @@
+#include "sass.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// A different stylesheet for every thread, touching the parts of
+// the compiler that use process wide tables (color names, units,
+// built-in functions, extend and the random generator).
+std::string make_source(size_t i) {
+  std::ostringstream src;
+  src << "$base: " << (i + 1) << "px;\n"
+      << "$colors: (a: red, b: rebeccapurple, c: #" << (100 + i % 900) << ");\n"
+      << "@function scale($v, $f) { @return $v * $f; }\n"
+      << "@mixin box($n) { width: scale($base, $n); height: $n * 1cm + 1mm; }\n"
+      << "%shared-" << i << " { color: lighten(blue, " << (i % 50) << "%); }\n"
+      << "@each $key, $color in $colors {\n"
+      << "  .item-#{$key}-" << i << " { @extend %shared-" << i << ";\n"
+      << "    @include box(" << (i % 7 + 1) << ");\n"
+      << "    background: mix($color, white, " << (i % 100) << "%);\n"
+      << "    content: to-upper-case(\"t#{$key}\") str-length(\"x" << i << "\");\n"
+      << "    r: random() < 1; }\n"
+      << "}\n"
+      << "@for $n from 1 through 20 { .n-#{$n} { w: percentage($n / 20); } }\n";
+  return src.str();
+}
+
+std::string compile(const std::string& source, bool* ok) {
+  char* input = sass_copy_c_string(source.c_str());
+  struct Sass_Data_Context* data_ctx = sass_make_data_context(input);
+  struct Sass_Context* ctx = sass_data_context_get_context(data_ctx);
+  *ok = sass_compile_data_context(data_ctx) == 0;
+  std::string output(*ok
+    ? sass_context_get_output_string(ctx)
+    : sass_context_get_error_message(ctx));
+  sass_delete_data_context(data_ctx);
+  return output;
+}
+
+size_t threads() {
+  if (const char* n = std::getenv("SASS_TEST_THREADS")) return std::atoi(n);
+  size_t n = std::thread::hardware_concurrency();
+  return n < 4 ? 4 : n;
+}
+
+size_t rounds() {
+  if (const char* n = std::getenv("SASS_TEST_ROUNDS")) return std::atoi(n);
+  return 20;
+}
+
+}  // namespace
+
+bool TestConcurrentCompiles() {
+  size_t N = threads(), R = rounds();
+  std::vector<std::string> sources, expected;
+  for (size_t i = 0; i < N; ++i) {
+    bool ok = false;
+    sources.push_back(make_source(i));
+    expected.push_back(compile(sources.back(), &ok));
+    if (!ok) {
+      std::cerr << "Reference compile failed: " << expected.back();
+      return false;
+    }
+  }
+  std::vector<size_t> mismatches(N, 0);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (size_t i = 0; i < N; ++i) {
+    pool.emplace_back([&, i]() {
+      for (size_t r = 0; r < R; ++r) {
+        bool ok = false;
+        if (compile(sources[i], &ok) != expected[i] || !ok) ++mismatches[i];
+      }
+    });
+  }
+  for (auto& thread : pool) thread.join();
+  std::chrono::duration<double> took = std::chrono::steady_clock::now() - start;
+  size_t failures = 0;
+  for (size_t m : mismatches) failures += m;
+  std::cerr << N << " threads, " << N * R << " compiles in "
+            << took.count() << "s (" << N * R / took.count()
+            << " per second)" << std::endl;
+  if (failures) {
+    std::cerr << failures << " compiles differed from the reference" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestConcurrentCompiles);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}
@@ -0,0 +1,89 @@
+#include "../src/utf8_string.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Sass::UTF_8::CodePoints;
+
+// compare the index with walking the string from the start
+bool matches_walk(const std::string& str) {
+  CodePoints code_points(str);
+  size_t count = utf8::distance(str.begin(), str.end());
+  if (code_points.count() != count) {
+    std::cerr << "Expected " << count << " code points, got "
+              << code_points.count() << std::endl;
+    return false;
+  }
+  for (size_t position = 0; position <= count; ++position) {
+    std::string::const_iterator it = str.begin();
+    utf8::advance(it, position, str.end());
+    size_t offset = it - str.begin();
+    if (code_points.offset_at_position(str, position) != offset) {
+      std::cerr << "Wrong offset for position " << position << std::endl;
+      return false;
+    }
+    if (code_points.position_at_offset(str, offset) != position) {
+      std::cerr << "Wrong position for offset " << offset << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+std::string repeat(const std::string& str, size_t times) {
+  std::string result;
+  for (size_t i = 0; i < times; ++i) result += str;
+  return result;
+}
+
+}  // namespace
+
+bool TestCodePointsAscii() {
+  CodePoints code_points("data:image/png;base64,");
+  return code_points.is_ascii() && matches_walk("data:image/png;base64,")
+    && matches_walk("") && CodePoints("").count() == 0;
+}
+
+bool TestCodePointsMultiByte() {
+  std::string str = "h\xC3\xA9llo \xE2\x9C\x93 \xF0\x9F\x98\x80";
+  return !CodePoints(str).is_ascii() && matches_walk(str);
+}
+
+bool TestCodePointsAcrossCheckpoints() {
+  // longer than many checkpoints, multi-byte at every boundary
+  return matches_walk(repeat("ab\xC3\xA9\xE2\x9C\x93", 97))
+    && matches_walk("\xC3\xA9" + repeat("x", 300));
+}
+
+bool TestCodePointsInvalid() {
+  try {
+    CodePoints code_points("ab\xFF" "cd");
+  } catch (const utf8::invalid_utf8&) {
+    return true;
+  }
+  return false;
+}
+
+#define TEST(fn) \
+  if (fn()) { \
+    passed.push_back(#fn); \
+  } else { \
+    failed.push_back(#fn); \
+    std::cerr << "Failed: " #fn << std::endl; \
+  } \
+
+int main(int argc, char **argv) {
+  std::vector<std::string> passed;
+  std::vector<std::string> failed;
+  TEST(TestCodePointsAscii);
+  TEST(TestCodePointsMultiByte);
+  TEST(TestCodePointsAcrossCheckpoints);
+  TEST(TestCodePointsInvalid);
+  std::cerr << argv[0] << ": Passed: " << passed.size()
+            << ", failed: " << failed.size()
+            << "." << std::endl;
+  return failed.size();
+}